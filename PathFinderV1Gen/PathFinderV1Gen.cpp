@@ -4,6 +4,7 @@
 #include "JSONPathReader.h"
 #include "PathCollection.h"
 #include "CSVWriter.h"
+#include "BinaryWriter.h"
 #include "PathTrajectory.h"
 #include "PathGenerator.h"
 #include "pathfinder.h"
@@ -14,6 +15,7 @@ using namespace xero::paths;
 std::string pathfile;
 std::string robotfile;
 std::string outfile;
+bool binary = false;
 std::string units = "in" ;
 int step = PATHFINDER_SAMPLES_LOW;
 double timestep = 0.02;
@@ -114,6 +116,10 @@ int main(int ac, char** av)
 			robotfile = *av++;
 			ac--;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
 		else if (arg == "--outfile")
 		{
 			if (ac == 0) {
@@ -211,11 +217,14 @@ void generateForPath(PathGroup & group, const std::string & path)
 		RobotPath::JerkTag,
 		RobotPath::HeadingTag
 	};
-	std::ofstream strm(outfile);
+	std::ofstream strm(outfile, binary ? std::ios::out | std::ios::binary : std::ios::out);
 	if (!strm.is_open())
 	{
 		std::cerr << "pathfinderV1: could not open file '" << outfile << "'" << std::endl;
 		return;
 	}
-	CSVWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory.begin(), trajectory.end());
+	if (binary)
+		BinaryWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory.begin(), trajectory.end());
+	else
+		CSVWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory.begin(), trajectory.end());
 }
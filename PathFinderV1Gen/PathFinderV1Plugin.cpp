@@ -0,0 +1,54 @@
+#include "PathGenerator.h"
+#include "pathfinder.h"
+#include <GeneratorPlugin.h>
+
+using namespace xero::paths;
+
+//
+// In process version of the PathFinderV1Gen program.  The defaults and the arguments
+// match the command line arguments processed in PathFinderV1Gen.cpp.
+//
+class PathFinderV1Plugin : public GeneratorPlugin
+{
+public:
+	PathFinderV1Plugin() {
+	}
+
+	virtual ~PathFinderV1Plugin() {
+	}
+
+	virtual std::shared_ptr<PathTrajectory> generate(const RobotParams& robot, const RobotPath& path,
+		double maxvel, double maxaccel, const std::vector<std::string>& args)
+	{
+		double timestep = robot.getTimestep();
+		int step = PATHFINDER_SAMPLES_LOW;
+		std::string str;
+		size_t index;
+
+		getDoubleArg(args, "--timestep", timestep);
+		if (getStringArg(args, "--step", str))
+		{
+			try {
+				step = std::stoi(str, &index);
+			}
+			catch (...)
+			{
+				throw std::runtime_error("expected integer following --step argument");
+			}
+
+			if (index != str.length())
+				throw std::runtime_error("expected integer following --step argument");
+		}
+
+		//
+		// The program passes the maximum velocity as the maximum acceleration, this is
+		// kept here on purpose so the plugin and the program produce the same trajectories.
+		//
+		(void)maxaccel;
+
+		PathGenerator gen(step, timestep);
+		return std::make_shared<PathTrajectory>(gen.generate(path.getPoints(), maxvel, maxvel, path.getMaxJerk()));
+	}
+};
+
+XERO_GENERATOR_PLUGIN(PathFinderV1Plugin)
@@ -15,4 +15,10 @@ CAPI double pf_spline_angle(Spline s, double percentage);
 CAPI double pf_spline_distance(Spline *s, int sample_count);
 CAPI double pf_spline_progress_for_distance(Spline s, double distance, int sample_count);
 
+// The same as pf_spline_distance and pf_spline_progress_for_distance, but the running arc
+// length at each of the sample_count + 1 samples is kept in table, so finding the progress
+// for a distance is a binary search instead of integrating the spline again
+CAPI double pf_spline_distance_table(Spline *s, int sample_count, double *table);
+CAPI double pf_spline_progress_for_distance_table(Spline s, double distance, const double *table, int sample_count);
+
 #endif
\ No newline at end of file
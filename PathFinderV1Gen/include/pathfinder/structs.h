@@ -33,6 +33,7 @@ CAPI typedef struct {
 CAPI typedef struct {
     Spline *saptr;
     double *laptr;
+    double *taptr;      // arc length tables, sample_count + 1 entries per spline
     double totalLength;
     int length;
     int path_length;
@@ -10,6 +10,7 @@ int pathfinder_prepare(const Waypoint *path, int path_length, void (*fit)(Waypoi
     
     cand->saptr = (Spline *)malloc((path_length - 1) * sizeof(Spline));
     cand->laptr = (double *)malloc((path_length - 1) * sizeof(double));
+    cand->taptr = (double *)malloc((size_t)(path_length - 1) * (sample_count + 1) * sizeof(double));
 
     if (cand->saptr == NULL) {
         pathfinder_set_error("Prepare: could not allocate splines array");
@@ -20,13 +21,18 @@ int pathfinder_prepare(const Waypoint *path, int path_length, void (*fit)(Waypoi
         pathfinder_set_error("Prepare: could not allocate lengths array");
         return -1;
     }
+
+    if (cand->taptr == NULL) {
+        pathfinder_set_error("Prepare: could not allocate arc length tables");
+        return -1;
+    }
     double totalLength = 0;
     
     int i;
     for (i = 0; i < path_length-1; i++) {
         Spline s;
         fit(path[i], path[i+1], &s);
-        double dist = pf_spline_distance(&s, sample_count);
+        double dist = pf_spline_distance_table(&s, sample_count, cand->taptr + (size_t)i * (sample_count + 1));
         cand->saptr[i] = s;
         cand->laptr[i] = dist;
         totalLength += dist;
@@ -102,7 +108,8 @@ int pathfinder_generate(TrajectoryCandidate *c, Segment *segments) {
             double pos_relative = pos - spline_pos_initial;
             if (pos_relative <= splineLengths[spline_i]) {
                 Spline si = splines[spline_i];
-                double percentage = pf_spline_progress_for_distance(si, pos_relative, c->config.sample_count);
+                const double *table = c->taptr + (size_t)spline_i * (c->config.sample_count + 1);
+                double percentage = pf_spline_progress_for_distance_table(si, pos_relative, table, c->config.sample_count);
                 Coord coords = pf_spline_coords(si, percentage);
                 segments[i].heading = pf_spline_angle(si, percentage);
                 segments[i].x = coords.x;
@@ -125,6 +132,7 @@ int pathfinder_generate(TrajectoryCandidate *c, Segment *segments) {
     
     free(c->saptr);
     free(c->laptr);
+    free(c->taptr);
     
     return trajectory_length;
 }
\ No newline at end of file
@@ -87,4 +87,60 @@ double pf_spline_progress_for_distance(Spline s, double distance, int sample_cou
             / (arc_length - last_arc_length) - 1) / sample_count_d;
     }
     return interpolated;
-}
\ No newline at end of file
+}
+
+double pf_spline_distance_table(Spline *s, int sample_count, double *table) {
+    double sample_count_d = (double) sample_count;
+    
+    double a = s->a; double b = s->b; double c = s->c; 
+    double d = s->d; double e = s->e; double knot = s->knot_distance;
+    
+    double arc_length = 0, t = 0, dydt = 0;
+    
+    double deriv0 = pf_spline_deriv_2(a, b, c, d, e, knot, 0);
+    
+    double integrand = 0;
+    double last_integrand = sqrt(1 + deriv0*deriv0) / sample_count_d;
+    
+    int i;
+    for (i = 0; i <= sample_count; i = i + 1) {
+        t = i / sample_count_d;
+        dydt = pf_spline_deriv_2(a, b, c, d, e, knot, t);
+        integrand = sqrt(1 + dydt*dydt) / sample_count_d;
+        arc_length += (integrand + last_integrand) / 2;
+        table[i] = arc_length;
+        last_integrand = integrand;
+    }
+    double al = knot * arc_length;
+    s->arc_length = al;
+    return al;
+}
+
+double pf_spline_progress_for_distance_table(Spline s, double distance, const double *table, int sample_count) {
+    double sample_count_d = (double) sample_count;
+    
+    distance /= s.knot_distance;
+    
+    // The first sample past the distance, as the integration in pf_spline_progress_for_distance
+    // stops at
+    int lo = 0, hi = sample_count + 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (table[mid] > distance)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    
+    if (lo > sample_count) return sample_count / sample_count_d;
+    
+    double arc_length = table[lo];
+    double last_arc_length = (lo == 0) ? 0 : table[lo - 1];
+    
+    double interpolated = lo / sample_count_d;
+    if (arc_length != last_arc_length) {
+        interpolated += ((distance - last_arc_length)
+            / (arc_length - last_arc_length) - 1) / sample_count_d;
+    }
+    return interpolated;
+}
@@ -57,17 +57,26 @@ int pf_trajectory_create(TrajectoryInfo info, TrajectoryConfig c, Segment *seg)
 
 int pf_trajectory_fromSecondOrderFilter(int filter_1_l, int filter_2_l, 
         double dt, double u, double v, double impulse, int len, Segment *t) {
+    if (len < 0 || filter_2_l < 1) {
+        // Error
+        return -1;
+    }
+    
     Segment last_section = {dt, 0, 0, 0, u, 0, 0};
     
-    if (len < 0) {
-        // Error
+    double *f1_buffer = (double *)malloc(filter_2_l * sizeof(double));
+    if (f1_buffer == NULL) {
+        pathfinder_set_error("Trajectory: could not allocate filter buffer");
         return -1;
     }
     
-    // double f1_buffer[len];
-    double *f1_buffer = (double *)malloc(len * sizeof(double));       // VS doesn't support VLAs
-    f1_buffer[0] = (u / v) * filter_1_l;
+    // The second filter is the sum of the last filter_2_l outputs of the first.  Those are
+    // kept in f1_buffer as a ring, and the sum is kept running by adding the newest output
+    // and taking away the one that drops out of the window.
+    double f1 = (u / v) * filter_1_l;
+    double f1_sum = 0;
     double f2;
+    int slot = 0;
     
     int i;
     for (i = 0; i < len; i++) {
@@ -79,21 +88,14 @@ int pf_trajectory_fromSecondOrderFilter(int filter_1_l, int filter_2_l,
             impulse -= input;
         }
 
-        double f1_last;
-        
-        if (i > 0) f1_last = f1_buffer[i - 1];
-        else f1_last = f1_buffer[0];
-
-        f1_buffer[i] = MAX(0.0, MIN(filter_1_l, f1_last + input));
+        f1 = MAX(0.0, MIN(filter_1_l, f1 + input));
 
-        f2 = 0;
-        int j;
-        for (j = 0; j < filter_2_l; ++j) {
-            if (i - j < 0) break;
+        if (i >= filter_2_l) f1_sum -= f1_buffer[slot];
+        f1_buffer[slot] = f1;
+        f1_sum += f1;
+        if (++slot == filter_2_l) slot = 0;
 
-            f2 += f1_buffer[i - j];
-        }
-        f2 = f2 / filter_1_l;
+        f2 = f1_sum / filter_1_l;
 
         t[i].velocity = f2 / filter_2_l * v;
 
@@ -110,4 +112,4 @@ int pf_trajectory_fromSecondOrderFilter(int filter_1_l, int filter_2_l,
     }
     free(f1_buffer);
     return 0;
-}
\ No newline at end of file
+}
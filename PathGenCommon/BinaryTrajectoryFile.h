@@ -0,0 +1,334 @@
+#pragma once
+
+//
+// The binary trajectory format, and a reader for it that only needs this header.
+//
+// A file holds one trajectory stored by column.  All values are little endian.
+//
+//     offset  size  contents
+//     0       8     magic, the characters "XEROTRJ" followed by a zero byte
+//     8       4     format version, currently 1
+//     12      4     number of columns
+//     16      8     number of rows
+//     24      8     reserved, zero
+//     32      32*n  the column table, one entry per column
+//                       24 bytes  column name, zero padded, at most 23 characters
+//                       8 bytes   offset of the column data from the start of the file
+//
+// The data for each column is the rows as IEEE-754 doubles and starts on a multiple
+// of eight bytes.  The column names are the ones used in the CSV files (time, x, y,
+// heading, position, velocity, acceleration, jerk, curvature, rotation) with the same
+// units, so heading is in degrees.  A reader should ignore columns it does not know
+// and reject a version it does not know.
+//
+// The reader maps the file into memory and hands out pointers straight into the
+// mapping, so nothing is parsed or copied.  It needs a little endian machine, which
+// covers every robot controller and desktop the tools run on.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace xero
+{
+	namespace paths
+	{
+		class BinaryTrajectoryFile
+		{
+		public:
+			static constexpr char Magic[8] = { 'X', 'E', 'R', 'O', 'T', 'R', 'J', '\0' };
+			static constexpr uint32_t Version = 1;
+			static constexpr size_t HeaderSize = 32;
+			static constexpr size_t ColumnEntrySize = 32;
+			static constexpr size_t ColumnNameSize = 24;
+
+		public:
+			BinaryTrajectoryFile() {
+				data_ = nullptr;
+				size_ = 0;
+				rows_ = 0;
+				columns_ = 0;
+				mapped_ = false;
+#ifdef _WIN32
+				file_ = INVALID_HANDLE_VALUE;
+				mapping_ = nullptr;
+#endif
+			}
+
+			~BinaryTrajectoryFile() {
+				close();
+			}
+
+			BinaryTrajectoryFile(const BinaryTrajectoryFile&) = delete;
+			BinaryTrajectoryFile& operator=(const BinaryTrajectoryFile&) = delete;
+
+			//
+			// Map a file into memory and check it is a trajectory file this reader understands
+			//
+			bool open(const std::string& filename) {
+				close();
+
+#ifdef _WIN32
+				file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file_ == INVALID_HANDLE_VALUE)
+					return fail("cannot open file");
+
+				LARGE_INTEGER size;
+				if (!GetFileSizeEx(file_, &size) || size.QuadPart < static_cast<LONGLONG>(HeaderSize))
+					return fail("file is too short to be a trajectory file");
+
+				mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mapping_ == nullptr)
+					return fail("cannot map file");
+
+				void* data = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+				if (data == nullptr)
+					return fail("cannot map file");
+
+				size_t length = static_cast<size_t>(size.QuadPart);
+#else
+				int fd = ::open(filename.c_str(), O_RDONLY);
+				if (fd < 0)
+					return fail("cannot open file");
+
+				struct stat st;
+				if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(HeaderSize))
+				{
+					::close(fd);
+					return fail("file is too short to be a trajectory file");
+				}
+
+				size_t length = static_cast<size_t>(st.st_size);
+				void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+				::close(fd);
+
+				if (data == MAP_FAILED)
+					return fail("cannot map file");
+#endif
+				mapped_ = true;
+				return load(data, length);
+			}
+
+			//
+			// Use a trajectory file that is already in memory.  The memory is not copied and
+			// must stay valid, and aligned for doubles, while this object is in use.
+			//
+			bool attach(const void* data, size_t size) {
+				close();
+				return load(data, size);
+			}
+
+			void close() {
+				if (mapped_)
+				{
+#ifdef _WIN32
+					UnmapViewOfFile(data_);
+#else
+					munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+				}
+
+#ifdef _WIN32
+				if (mapping_ != nullptr)
+					CloseHandle(mapping_);
+				if (file_ != INVALID_HANDLE_VALUE)
+					CloseHandle(file_);
+				file_ = INVALID_HANDLE_VALUE;
+				mapping_ = nullptr;
+#endif
+				data_ = nullptr;
+				size_ = 0;
+				rows_ = 0;
+				columns_ = 0;
+				mapped_ = false;
+			}
+
+			bool isOpen() const {
+				return data_ != nullptr;
+			}
+
+			const std::string& error() const {
+				return error_;
+			}
+
+			size_t rows() const {
+				return rows_;
+			}
+
+			size_t columnCount() const {
+				return columns_;
+			}
+
+			std::string columnName(size_t index) const {
+				if (index >= columns_)
+					return std::string();
+
+				const char* name = reinterpret_cast<const char*>(entry(index));
+				return std::string(name, strnlen(name, ColumnNameSize));
+			}
+
+			//
+			// The data for a column, or nullptr if the file has no column with this name
+			//
+			const double* column(const char* name) const {
+				size_t len = std::strlen(name);
+				if (len >= ColumnNameSize)
+					return nullptr;
+
+				for (size_t i = 0; i < columns_; i++)
+				{
+					const unsigned char* e = entry(i);
+					if (std::memcmp(e, name, len + 1) == 0)
+						return reinterpret_cast<const double*>(data_ + readU64(e + ColumnNameSize));
+				}
+
+				return nullptr;
+			}
+
+			const double* times() const {
+				return column("time");
+			}
+
+			const double* xs() const {
+				return column("x");
+			}
+
+			const double* ys() const {
+				return column("y");
+			}
+
+			const double* headings() const {
+				return column("heading");
+			}
+
+			const double* positions() const {
+				return column("position");
+			}
+
+			const double* velocities() const {
+				return column("velocity");
+			}
+
+			const double* accelerations() const {
+				return column("acceleration");
+			}
+
+			const double* jerks() const {
+				return column("jerk");
+			}
+
+			const double* curvatures() const {
+				return column("curvature");
+			}
+
+			const double* rotations() const {
+				return column("rotation");
+			}
+
+			//
+			// True if the bytes given start like a trajectory file
+			//
+			static bool hasMagic(const void* data, size_t size) {
+				return size >= sizeof(Magic) && std::memcmp(data, Magic, sizeof(Magic)) == 0;
+			}
+
+			static bool littleEndian() {
+				const uint16_t one = 1;
+				unsigned char first;
+				std::memcpy(&first, &one, 1);
+				return first == 1;
+			}
+
+		private:
+			static uint32_t readU32(const unsigned char* p) {
+				return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+					(static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+			}
+
+			static uint64_t readU64(const unsigned char* p) {
+				return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+			}
+
+			const unsigned char* entry(size_t index) const {
+				return data_ + HeaderSize + index * ColumnEntrySize;
+			}
+
+			bool fail(const char* msg) {
+				error_ = msg;
+				close();
+				return false;
+			}
+
+			bool load(const void* data, size_t size) {
+				data_ = static_cast<const unsigned char*>(data);
+				size_ = size;
+
+				if (!littleEndian())
+					return fail("trajectory files can only be read on little endian machines");
+
+				if (size < HeaderSize || !hasMagic(data, size))
+					return fail("not a trajectory file");
+
+				if (reinterpret_cast<uintptr_t>(data) % alignof(double) != 0)
+					return fail("trajectory data is not aligned");
+
+				if (readU32(data_ + 8) != Version)
+					return fail("unsupported trajectory file version");
+
+				uint64_t columns = readU32(data_ + 12);
+				uint64_t rows = readU64(data_ + 16);
+
+				if (columns > (size - HeaderSize) / ColumnEntrySize)
+					return fail("column table is past the end of the file");
+
+				if (rows > size / sizeof(double))
+					return fail("column data is past the end of the file");
+
+				for (size_t i = 0; i < columns; i++)
+				{
+					const unsigned char* e = data_ + HeaderSize + i * ColumnEntrySize;
+					uint64_t offset = readU64(e + ColumnNameSize);
+
+					if (e[ColumnNameSize - 1] != 0)
+						return fail("column name is not terminated");
+
+					if (offset % sizeof(double) != 0 || offset > size || rows * sizeof(double) > size - offset)
+						return fail("column data is past the end of the file");
+				}
+
+				columns_ = static_cast<size_t>(columns);
+				rows_ = static_cast<size_t>(rows);
+				return true;
+			}
+
+		private:
+			const unsigned char* data_;
+			size_t size_;
+			size_t rows_;
+			size_t columns_;
+			bool mapped_;
+			std::string error_;
+#ifdef _WIN32
+			HANDLE file_;
+			HANDLE mapping_;
+#endif
+		};
+	}
+}
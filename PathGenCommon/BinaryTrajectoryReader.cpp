@@ -0,0 +1,57 @@
+#include "BinaryTrajectoryReader.h"
+#include "BinaryTrajectoryFile.h"
+#include <fstream>
+
+namespace xero
+{
+	namespace paths
+	{
+		bool BinaryTrajectoryReader::isBinary(const std::string& filename)
+		{
+			char magic[sizeof(BinaryTrajectoryFile::Magic)];
+
+			std::ifstream in(filename, std::ios::binary);
+			if (!in.is_open() || !in.read(magic, sizeof(magic)))
+				return false;
+
+			return BinaryTrajectoryFile::hasMagic(magic, sizeof(magic));
+		}
+
+		bool BinaryTrajectoryReader::read(const std::string& filename, PathTrajectory& traj)
+		{
+			BinaryTrajectoryFile file;
+
+			if (!file.open(filename))
+				return false;
+
+			return read(file, traj);
+		}
+
+		bool BinaryTrajectoryReader::read(const BinaryTrajectoryFile& file, PathTrajectory& traj)
+		{
+			const double* time = file.times();
+			const double* x = file.xs();
+			const double* y = file.ys();
+			const double* heading = file.headings();
+			const double* position = file.positions();
+			const double* velocity = file.velocities();
+			const double* acceleration = file.accelerations();
+			const double* jerk = file.jerks();
+			const double* curvature = file.curvatures();
+			const double* rotation = file.rotations();
+
+			if (time == nullptr || x == nullptr || y == nullptr || heading == nullptr || position == nullptr ||
+				velocity == nullptr || acceleration == nullptr || jerk == nullptr)
+				return false;
+
+			traj.reserve(traj.size() + file.rows());
+			for (size_t i = 0; i < file.rows(); i++)
+			{
+				traj.push_back(time[i], x[i], y[i], Rotation2d::fromDegrees(heading[i]), position[i], velocity[i],
+					acceleration[i], jerk[i], curvature != nullptr ? curvature[i] : 0.0, rotation != nullptr ? rotation[i] : 0.0);
+			}
+
+			return true;
+		}
+	}
+}
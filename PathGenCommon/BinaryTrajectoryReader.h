@@ -0,0 +1,39 @@
+#pragma once
+
+#include "PathTrajectory.h"
+#include <string>
+
+namespace xero
+{
+	namespace paths
+	{
+		class BinaryTrajectoryFile;
+
+		//
+		// Reads a binary trajectory file, as written by BinaryWriter, into the columns of
+		// a trajectory
+		//
+		class BinaryTrajectoryReader
+		{
+		public:
+			BinaryTrajectoryReader() = delete;
+			~BinaryTrajectoryReader() = delete;
+
+			//
+			// True if the file given starts like a binary trajectory file
+			//
+			static bool isBinary(const std::string& filename);
+
+			//
+			// Read the file given, returns false if the file cannot be read or is missing
+			// one of the required columns.  Curvature and rotation are optional.
+			//
+			static bool read(const std::string& filename, PathTrajectory& traj);
+
+			//
+			// Read a trajectory file that is already open, or attached to memory
+			//
+			static bool read(const BinaryTrajectoryFile& file, PathTrajectory& traj);
+		};
+	}
+}
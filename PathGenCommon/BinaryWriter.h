@@ -0,0 +1,142 @@
+#pragma once
+#include "ICsv.h"
+#include "PathTrajectory.h"
+#include "BinaryTrajectoryFile.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace xero
+{
+	namespace paths
+	{
+		//
+		// Writes trajectories in the binary format described in BinaryTrajectoryFile.h, one
+		// column for each header.  The stream must be opened in binary mode.
+		//
+		class BinaryWriter
+		{
+		public:
+			BinaryWriter() = delete;
+			~BinaryWriter() = delete;
+
+			template<class InputIt>
+			static bool write(std::ostream& strm, std::vector<std::string>& headers, InputIt first, InputIt last)
+			{
+				std::vector<std::vector<double>> values(headers.size());
+
+				for (auto it = first; it != last; it++)
+				{
+					const ICsv& cl = *it;
+					for (size_t i = 0; i < headers.size(); i++)
+						values[i].push_back(cl.getField(headers[i]));
+				}
+
+				std::vector<const double*> columns;
+				for (const std::vector<double>& column : values)
+					columns.push_back(column.data());
+
+				return writeColumns(strm, headers, columns, values.empty() ? 0 : values[0].size());
+			}
+
+		private:
+			static void putU32(unsigned char* p, uint32_t v)
+			{
+				for (int i = 0; i < 4; i++)
+					p[i] = static_cast<unsigned char>(v >> (8 * i));
+			}
+
+			static void putU64(unsigned char* p, uint64_t v)
+			{
+				putU32(p, static_cast<uint32_t>(v));
+				putU32(p + 4, static_cast<uint32_t>(v >> 32));
+			}
+
+			//
+			// Write the header, the column table and then each column.  A null column is
+			// written as all NaN.
+			//
+			static bool writeColumns(std::ostream& strm, const std::vector<std::string>& names, const std::vector<const double*>& columns, size_t rows)
+			{
+				size_t tablesize = BinaryTrajectoryFile::HeaderSize + names.size() * BinaryTrajectoryFile::ColumnEntrySize;
+				std::vector<unsigned char> table(tablesize, 0);
+
+				std::memcpy(&table[0], BinaryTrajectoryFile::Magic, sizeof(BinaryTrajectoryFile::Magic));
+				putU32(&table[8], BinaryTrajectoryFile::Version);
+				putU32(&table[12], static_cast<uint32_t>(names.size()));
+				putU64(&table[16], rows);
+
+				for (size_t i = 0; i < names.size(); i++)
+				{
+					unsigned char* entry = &table[BinaryTrajectoryFile::HeaderSize + i * BinaryTrajectoryFile::ColumnEntrySize];
+					if (names[i].length() >= BinaryTrajectoryFile::ColumnNameSize)
+						return false;
+
+					std::memcpy(entry, names[i].c_str(), names[i].length());
+					putU64(entry + BinaryTrajectoryFile::ColumnNameSize, tablesize + i * rows * sizeof(double));
+				}
+
+				strm.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size()));
+
+				std::vector<double> nans;
+				std::vector<unsigned char> swapped;
+				bool little = BinaryTrajectoryFile::littleEndian();
+
+				for (const double* column : columns)
+				{
+					if (column == nullptr)
+					{
+						nans.resize(rows, std::nan(""));
+						column = nans.data();
+					}
+
+					if (little)
+					{
+						strm.write(reinterpret_cast<const char*>(column), static_cast<std::streamsize>(rows * sizeof(double)));
+					}
+					else
+					{
+						swapped.resize(rows * sizeof(double));
+						for (size_t row = 0; row < rows; row++)
+						{
+							uint64_t bits;
+							std::memcpy(&bits, &column[row], sizeof(bits));
+							putU64(&swapped[row * sizeof(double)], bits);
+						}
+						strm.write(reinterpret_cast<const char*>(swapped.data()), static_cast<std::streamsize>(swapped.size()));
+					}
+				}
+
+				return !strm.fail();
+			}
+		};
+
+		//
+		// The columns of a trajectory are written straight from its storage
+		//
+		template<>
+		inline bool BinaryWriter::write<PathTrajectory::const_iterator>(std::ostream& strm, std::vector<std::string>& headers,
+			PathTrajectory::const_iterator first, PathTrajectory::const_iterator last)
+		{
+			std::vector<const double*> columns(headers.size(), nullptr);
+			size_t rows = 0;
+
+			if (first != last)
+			{
+				std::vector<const std::vector<double>*> data = first.trajectory()->columns(headers);
+
+				rows = last.index() - first.index();
+				for (size_t i = 0; i < data.size(); i++)
+				{
+					if (data[i] != nullptr)
+						columns[i] = data[i]->data() + first.index();
+				}
+			}
+
+			return writeColumns(strm, headers, columns, rows);
+		}
+	}
+}
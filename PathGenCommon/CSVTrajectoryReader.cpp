@@ -0,0 +1,171 @@
+#include "CSVTrajectoryReader.h"
+#include <algorithm>
+#include <fstream>
+#include <charconv>
+#include <cstdlib>
+
+namespace xero
+{
+	namespace paths
+	{
+		bool CSVTrajectoryReader::read(const std::string& filename, PathTrajectory& traj)
+		{
+			std::ifstream in(filename, std::ios::binary);
+			if (!in.is_open())
+				return false;
+
+			in.seekg(0, std::ios::end);
+			std::streamoff size = in.tellg();
+			if (size <= 0)
+				return false;
+
+			std::string text(static_cast<size_t>(size), '\0');
+			in.seekg(0, std::ios::beg);
+			if (!in.read(&text[0], size))
+				return false;
+
+			return parse(text, traj);
+		}
+
+		bool CSVTrajectoryReader::parse(const std::string& text, PathTrajectory& traj)
+		{
+			static const TrajectoryColumn required[] =
+			{
+				TrajectoryColumn::Time,
+				TrajectoryColumn::X,
+				TrajectoryColumn::Y,
+				TrajectoryColumn::Heading,
+				TrajectoryColumn::Position,
+				TrajectoryColumn::Velocity,
+				TrajectoryColumn::Acceleration,
+				TrajectoryColumn::Jerk,
+			};
+			static const size_t kColumnCount = static_cast<size_t>(TrajectoryColumn::Unknown) + 1;
+
+			const char* p = text.c_str();
+			const char* last = p + text.length();
+			std::vector<TrajectoryColumn> columns;
+
+			if (!parseHeaders(p, last, columns))
+				return false;
+
+			//
+			// Find the position of each value in a row, curvature and rotation are optional
+			//
+			size_t where[kColumnCount];
+			std::fill(where, where + kColumnCount, columns.size());
+			for (size_t i = 0; i < columns.size(); i++)
+				where[static_cast<size_t>(columns[i])] = i;
+
+			for (TrajectoryColumn c : required)
+			{
+				if (where[static_cast<size_t>(c)] == columns.size())
+					return false;
+			}
+
+			traj.reserve(traj.size() + std::count(p, last, '\n') + 1);
+
+			//
+			// One extra slot, always zero, for optional values that are not in the file
+			//
+			std::vector<double> row(columns.size() + 1, 0.0);
+			auto value = [&row, &where](TrajectoryColumn c) { return row[where[static_cast<size_t>(c)]]; };
+
+			while (p < last)
+			{
+				if (*p == '\n' || *p == '\r')
+				{
+					p++;
+					continue;
+				}
+
+				for (size_t i = 0; i < columns.size(); i++)
+				{
+					if (!parseNumber(p, last, row[i]))
+						return false;
+
+					if (i != columns.size() - 1)
+					{
+						if (p == last || *p != ',')
+							return false;
+						p++;
+					}
+				}
+
+				if (p < last && *p == '\r')
+					p++;
+
+				if (p < last && *p++ != '\n')
+					return false;
+
+				traj.push_back(value(TrajectoryColumn::Time), value(TrajectoryColumn::X), value(TrajectoryColumn::Y),
+					Rotation2d::fromDegrees(value(TrajectoryColumn::Heading)), value(TrajectoryColumn::Position),
+					value(TrajectoryColumn::Velocity), value(TrajectoryColumn::Acceleration), value(TrajectoryColumn::Jerk),
+					value(TrajectoryColumn::Curvature), value(TrajectoryColumn::Rotation));
+			}
+
+			return true;
+		}
+
+		bool CSVTrajectoryReader::parseHeaders(const char*& p, const char* last, std::vector<TrajectoryColumn>& columns)
+		{
+			const char* eol = std::find(p, last, '\n');
+			if (eol == p)
+				return false;
+
+			while (true)
+			{
+				const char* start = p;
+				const char* end = std::find(p, eol, ',');
+
+				p = end;
+				while (end > start && (end[-1] == '\r' || end[-1] == ' '))
+					end--;
+
+				if (end - start >= 2 && *start == '"' && end[-1] == '"')
+				{
+					start++;
+					end--;
+				}
+
+				columns.push_back(Pose2dWithTrajectory::columnFromName(std::string(start, end)));
+
+				if (p == eol)
+					break;
+				p++;
+			}
+
+			p = (eol == last) ? last : eol + 1;
+			return true;
+		}
+
+		bool CSVTrajectoryReader::parseNumber(const char*& p, const char* last, double& value)
+		{
+			while (p < last && *p == ' ')
+				p++;
+
+			if (p < last && *p == '+')
+				p++;
+
+#if defined(__cpp_lib_to_chars)
+			std::from_chars_result result = std::from_chars(p, last, value);
+			if (result.ec != std::errc())
+				return false;
+
+			p = result.ptr;
+#else
+			//
+			// No floating point from_chars in this library, the text always ends in a
+			// nul so strtod cannot run past the end
+			//
+			char* end;
+			value = std::strtod(p, &end);
+			if (end == p)
+				return false;
+
+			p = end;
+#endif
+			return true;
+		}
+	}
+}
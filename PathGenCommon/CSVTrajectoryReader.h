@@ -0,0 +1,37 @@
+#pragma once
+
+#include "PathTrajectory.h"
+#include <string>
+
+namespace xero
+{
+	namespace paths
+	{
+		//
+		// Reads the CSV output of the path generation programs straight into the columns
+		// of a trajectory.  The whole file is read at once, the header names are mapped to
+		// columns once, and each row is parsed in place with no per field strings.
+		//
+		class CSVTrajectoryReader
+		{
+		public:
+			CSVTrajectoryReader() = delete;
+			~CSVTrajectoryReader() = delete;
+
+			//
+			// Read the file given, returns false if the file cannot be read, is missing
+			// one of the required columns, or has a row that is not all numbers
+			//
+			static bool read(const std::string& filename, PathTrajectory& traj);
+
+			//
+			// Parse CSV text that is already in memory
+			//
+			static bool parse(const std::string& text, PathTrajectory& traj);
+
+		private:
+			static bool parseHeaders(const char*& p, const char* last, std::vector<TrajectoryColumn>& columns);
+			static bool parseNumber(const char*& p, const char* last, double& value);
+		};
+	}
+}
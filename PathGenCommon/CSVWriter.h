@@ -1,5 +1,8 @@
 #pragma once
 #include "ICsv.h"
+#include "PathTrajectory.h"
+#include "OutputBuffer.h"
+#include <cmath>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -9,6 +12,10 @@ namespace xero
 {
 	namespace paths
 	{
+		//
+		// The rows are formatted into the calling thread's OutputBuffer, using its number
+		// format, and written to the stream with a single call
+		//
 		class CSVWriter
 		{
 		public:
@@ -18,13 +25,10 @@ namespace xero
 			template<class InputIt>
 			static bool write(std::ostream &strm, std::vector<std::string> &headers, InputIt first, InputIt last)
 			{
-				for (size_t i = 0; i < headers.size(); i++)
-				{
-					strm << '"' << headers[i] << '"';
-					if (i != headers.size() - 1)
-						strm << ",";
-				}
-				strm << std::endl;
+				OutputBuffer& out = OutputBuffer::local();
+
+				out.clear();
+				writeHeaders(out, headers);
 
 				for (auto it = first; it != last; it++)
 				{
@@ -33,17 +37,61 @@ namespace xero
 					{
 						double v = cl.getField(headers[i]);
 						if (i != 0)
-							strm << "," ;
+							out << ',';
 
-						strm << v;
+						out << v;
 					}
-					strm << std::endl;
+					out << '\n';
 				}
 
-				return true;
+				return out.write(strm);
+			}
+
+		private:
+			static void writeHeaders(OutputBuffer& out, std::vector<std::string>& headers)
+			{
+				for (size_t i = 0; i < headers.size(); i++)
+				{
+					out << '"' << headers[i] << '"';
+					if (i != headers.size() - 1)
+						out << ',';
+				}
+				out << '\n';
 			}
 		};
-	}
-}
 
+		//
+		// A trajectory stores its values in columns, so look up the column for each header
+		// once and then copy the values straight out of the columns
+		//
+		template<>
+		inline bool CSVWriter::write<PathTrajectory::const_iterator>(std::ostream& strm, std::vector<std::string>& headers,
+			PathTrajectory::const_iterator first, PathTrajectory::const_iterator last)
+		{
+			OutputBuffer& out = OutputBuffer::local();
+
+			out.clear();
+			writeHeaders(out, headers);
+
+			if (first != last)
+			{
+				std::vector<const std::vector<double>*> columns = first.trajectory()->columns(headers);
+				double nan = std::nan("");
+
+				for (size_t row = first.index(); row < last.index(); row++)
+				{
+					for (size_t i = 0; i < columns.size(); i++)
+					{
+						if (i != 0)
+							out << ',';
 
+						out << (columns[i] != nullptr ? (*columns[i])[row] : nan);
+					}
+					out << '\n';
+				}
+			}
+
+			return out.write(strm);
+		}
+	}
+}
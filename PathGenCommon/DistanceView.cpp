@@ -7,36 +7,43 @@ namespace xero
 		DistanceView::DistanceView(const std::vector<Pose2d>& points, double step)
 		{
 			static const double kEpsilon = 1e-6;
+			std::vector<double> dists;
 			double d;
 
-			distances_.push_back(0.0);
+			dists.reserve(points.size());
+			dists.push_back(0.0);
 			for (size_t i = 1; i < points.size(); i++)
-				distances_.push_back(points[i].distance(points[i - 1]) + distances_[i - 1]);
+				dists.push_back(points[i].distance(points[i - 1]) + dists[i - 1]);
+
+			points_.reserve(static_cast<size_t>(dists.back() / step) + 2);
 
 			size_t index = 0;
-			for (d = 0.0; d <= distances_.back(); d += step)
+			for (d = 0.0; d <= dists.back(); d += step)
 			{
-				while (d > distances_[index + 1])
+				while (d > dists[index + 1])
 					index++;
 
-				double percent = (d - distances_[index]) / (distances_[index + 1] - distances_[index]);
+				double percent = (d - dists[index]) / (dists[index + 1] - dists[index]);
 				Pose2d newpt = points[index].interpolate(points[index + 1], percent);
 				points_.push_back(Pose2dWithCurvature(newpt, 0));
 			}
 
-			distances_.clear();
+			distances_.reserve(points_.size());
 			distances_.push_back(0.0);
 			for (size_t i = 1; i < points_.size(); i++)
 				distances_.push_back(points_[i].distance(points_[i - 1]) + distances_[i - 1]);
 
-			for (int i = 1; i < points_.size() - 1; i++)
+			for (size_t i = 1; i < points_.size() - 1; i++)
 				points_[i].setCurvature(Pose2dWithCurvature::curvature(points_[i - 1], points_[i], points_[i + 1]));
 
 		}
 
-		Pose2dWithCurvature DistanceView::operator[](double dist) const
+		//
+		// Returns the first index past zero whose distance is not less than dist, or
+		// the number of points if dist is past the end of the view
+		//
+		size_t DistanceView::search(double dist) const
 		{
-			Pose2d result;
 			size_t low = 0;
 			size_t high = distances_.size();
 
@@ -49,19 +56,53 @@ namespace xero
 					high = mid;
 			}
 
+			return high;
+		}
+
+		Pose2dWithCurvature DistanceView::interpolate(size_t high, double dist) const
+		{
+			size_t low = high - 1;
+
 			if (high == distances_.size())
-				result = points_[low];
+				return points_[low];
+
+			double percent = (dist - distances_[low]) / (distances_[high] - distances_[low]);
+			return points_[low].interpolate(points_[high], percent);
+		}
+
+		Pose2dWithCurvature DistanceView::operator[](double dist) const
+		{
+			return interpolate(search(dist), dist);
+		}
+
+		void DistanceView::sample(const std::vector<double>& dists, std::vector<Pose2dWithCurvature>& results) const
+		{
+			Cursor cur(*this);
+
+			results.clear();
+			results.reserve(dists.size());
+			for (double dist : dists)
+				results.push_back(cur[dist]);
+		}
+
+		Pose2dWithCurvature DistanceView::Cursor::operator[](double dist)
+		{
+			const std::vector<double>& distances = view_.distances_;
+
+			if (high_ > 1 && dist <= distances[high_ - 1])
+			{
+				//
+				// Moved backward, start over
+				//
+				high_ = view_.search(dist);
+			}
 			else
 			{
-				double percent = (dist - distances_[low]) / (distances_[high] - distances_[low]);
-				result = points_[low].interpolate(points_[high], percent);
+				while (high_ < distances.size() && distances[high_] < dist)
+					high_++;
 			}
 
-			return result;
-		}
-
-		Pose2dWithCurvature DistanceView::operator[](size_t index) const {
-			return points_[index];
+			return view_.interpolate(high_, dist);
 		}
 	}
-}
\ No newline at end of file
+}
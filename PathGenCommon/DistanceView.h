@@ -9,6 +9,26 @@ namespace xero
 	{
 		class DistanceView
 		{
+		public:
+			//
+			// Walks forward through a distance view.  Lookups with distances that do not
+			// decrease take amortized constant time, since the search picks up where the
+			// last one left off.  Going backward falls back to a binary search.
+			//
+			class Cursor
+			{
+			public:
+				Cursor(const DistanceView& view) : view_(view) {
+					high_ = 1;
+				}
+
+				Pose2dWithCurvature operator[](double dist);
+
+			private:
+				const DistanceView& view_;
+				size_t high_;
+			};
+
 		public:
 			DistanceView(const std::vector<Pose2d>& points, double delta);
 			double length() const {
@@ -19,16 +39,31 @@ namespace xero
 				return distances_[index];
 			}
 
+			Cursor cursor() const {
+				return Cursor(*this);
+			}
+
 			Pose2dWithCurvature operator[](double dist) const;
-			Pose2dWithCurvature operator[](size_t index) const;
+			const Pose2dWithCurvature& operator[](size_t index) const {
+				return points_[index];
+			}
+
 			size_t size() const {
 				return points_.size();
 			}
 
+			//
+			// Look up a set of distances, fastest when they are sorted
+			//
+			void sample(const std::vector<double>& dists, std::vector<Pose2dWithCurvature>& results) const;
+
+		private:
+			size_t search(double dist) const;
+			Pose2dWithCurvature interpolate(size_t high, double dist) const;
+
 		private:
 			std::vector<double> distances_;
 			std::vector<Pose2dWithCurvature> points_;
 		};
 	}
 }
-
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "PathTrajectory.h"
+#include "RobotParams.h"
+#include "RobotPath.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// \file
+
+#ifdef _MSC_VER
+#define XERO_GENERATOR_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+#define XERO_GENERATOR_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+namespace xero
+{
+	namespace paths
+	{
+		/// \brief one path, prepared for generation with different velocity limits
+		/// The work that depends only on the waypoints (splines, parameterization) is done
+		/// once when the session is created, and each call to generate() only redoes the
+		/// work that depends on the velocity limits.  A session is used by one thread at a time.
+		class GeneratorSession
+		{
+		public:
+			GeneratorSession() {
+			}
+
+			virtual ~GeneratorSession() {
+			}
+
+			/// \brief generate the main trajectory for the path using the given limits
+			/// \param maxvel the maximum velocity to use
+			/// \param maxaccel the maximum acceleration to use
+			/// \returns the main trajectory for the path
+			/// \throws std::runtime_error if the trajectory cannot be generated
+			virtual std::shared_ptr<PathTrajectory> generate(double maxvel, double maxaccel) = 0;
+		};
+
+		/// \brief a path generator that runs inside the calling process
+		/// A generator that ships a shared library alongside its executable can be loaded
+		/// by the path generation engine and called directly instead of being launched as a
+		/// separate program for every path.  The arguments given to the plugin are the same
+		/// arguments that would be given on the command line of the generator program,
+		/// minus the robot, path and output file arguments.  The plugin and the host must be
+		/// built from the same PathGenCommon sources with the same compiler.
+		class GeneratorPlugin
+		{
+		public:
+			/// \brief the version of this interface, bumped any time the interface changes
+			static constexpr int InterfaceVersion = 2;
+
+			/// \brief the name of the function exported by the shared library to create the plugin
+			static constexpr const char* EntryPointName = "xeroCreateGeneratorPlugin";
+
+		public:
+			GeneratorPlugin() {
+			}
+
+			virtual ~GeneratorPlugin() {
+			}
+
+			/// \brief generate the main trajectory for a path
+			/// This method may be called from several threads at once and must not keep any
+			/// state between calls.
+			/// \param robot the robot the path is being generated for
+			/// \param path the path to generate
+			/// \param maxvel the maximum velocity to use, overrides the path maximum velocity
+			/// \param maxaccel the maximum acceleration to use, overrides the path maximum acceleration
+			/// \param args the generator arguments, in command line form
+			/// \returns the main trajectory for the path
+			/// \throws std::runtime_error if the trajectory cannot be generated
+			virtual std::shared_ptr<PathTrajectory> generate(const RobotParams& robot, const RobotPath& path,
+				double maxvel, double maxaccel, const std::vector<std::string>& args) = 0;
+
+			/// \brief create a session to generate a path several times with different velocity limits
+			/// Generators that cannot reuse any work between calls do not need to override this.
+			/// \param robot the robot the path is being generated for
+			/// \param path the path to generate
+			/// \param args the generator arguments, in command line form
+			/// \returns a session for the path, or nullptr if the generator does not support sessions
+			/// \throws std::runtime_error if the arguments are not valid
+			virtual std::shared_ptr<GeneratorSession> createSession(const RobotParams& robot, const RobotPath& path,
+				const std::vector<std::string>& args) {
+				(void)robot;
+				(void)path;
+				(void)args;
+				return nullptr;
+			}
+
+		protected:
+			static bool getStringArg(const std::vector<std::string>& args, const std::string& name, std::string& value) {
+				for (size_t i = 0; i + 1 < args.size(); i++)
+				{
+					if (args[i] == name)
+					{
+						value = args[i + 1];
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			static bool getDoubleArg(const std::vector<std::string>& args, const std::string& name, double& value) {
+				std::string str;
+				size_t index;
+
+				if (!getStringArg(args, name, str))
+					return false;
+
+				try {
+					value = std::stod(str, &index);
+				}
+				catch (...)
+				{
+					throw std::runtime_error("expected floating point number following " + name + " argument");
+				}
+
+				if (index != str.length())
+					throw std::runtime_error("expected floating point number following " + name + " argument");
+
+				return true;
+			}
+		};
+
+		typedef GeneratorPlugin* (*GeneratorPluginEntry)(int version);
+	}
+}
+
+/// \brief define the entry point for a shared library containing a generator plugin
+#define XERO_GENERATOR_PLUGIN(cls)															\
+	XERO_GENERATOR_PLUGIN_EXPORT xero::paths::GeneratorPlugin* xeroCreateGeneratorPlugin(int version)	\
+	{																						\
+		if (version != xero::paths::GeneratorPlugin::InterfaceVersion)						\
+			return nullptr;																	\
+		return new cls();																	\
+	}
@@ -0,0 +1,455 @@
+#include "JSONDocument.h"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace xero
+{
+	namespace paths
+	{
+		std::string JSONDocument::Value::asString() const
+		{
+			if (!isString())
+				return std::string();
+
+			const Node& n = node();
+			return doc_->text_.substr(n.first_, n.count_);
+		}
+
+		std::string JSONDocument::Value::key() const
+		{
+			if (doc_ == nullptr)
+				return std::string();
+
+			const Node& n = node();
+			return doc_->text_.substr(n.keyoff_, n.keylen_);
+		}
+
+		JSONDocument::Value JSONDocument::Value::operator[](size_t index) const
+		{
+			if (index >= size())
+				return Value();
+
+			return Value(doc_, node().first_ + index);
+		}
+
+		JSONDocument::Value JSONDocument::Value::operator[](const char* key) const
+		{
+			if (!isObject())
+				return Value();
+
+			const Node& n = node();
+			const char* text = doc_->text_.data();
+			size_t len = std::strlen(key);
+
+			for (size_t i = n.count_; i > 0; i--)
+			{
+				const Node& member = doc_->nodes_[n.first_ + i - 1];
+				if (member.keylen_ == len && std::memcmp(text + member.keyoff_, key, len) == 0)
+					return Value(doc_, n.first_ + i - 1);
+			}
+
+			return Value();
+		}
+
+		JSONDocument::JSONDocument()
+		{
+			pos_ = 0;
+			root_ = 0;
+		}
+
+		bool JSONDocument::readFile(const std::string& filename)
+		{
+			std::ifstream in(filename, std::ios::binary);
+			if (!in.is_open())
+			{
+				error_ = "cannot open file";
+				return false;
+			}
+
+			in.seekg(0, std::ios::end);
+			std::streamoff size = in.tellg();
+			if (size < 0)
+			{
+				error_ = "cannot read file";
+				return false;
+			}
+
+			std::string text(static_cast<size_t>(size), '\0');
+			in.seekg(0, std::ios::beg);
+			if (size > 0 && !in.read(&text[0], size))
+			{
+				error_ = "cannot read file";
+				return false;
+			}
+
+			return parse(std::move(text));
+		}
+
+		bool JSONDocument::parse(std::string text)
+		{
+			text_ = std::move(text);
+			pos_ = 0;
+			nodes_.clear();
+			stack_.clear();
+			error_.clear();
+
+			//
+			// Skip a UTF-8 byte order mark if there is one
+			//
+			if (text_.compare(0, 3, "\xEF\xBB\xBF") == 0)
+				pos_ = 3;
+
+			Node root = Node();
+			skipWhitespace();
+			if (!parseValue(root, 0))
+			{
+				nodes_.clear();
+				return false;
+			}
+
+			skipWhitespace();
+			if (pos_ != text_.size())
+			{
+				nodes_.clear();
+				return fail("unexpected text after the end of the document");
+			}
+
+			root_ = nodes_.size();
+			nodes_.push_back(root);
+			return true;
+		}
+
+		bool JSONDocument::fail(const char* msg)
+		{
+			size_t line = 1;
+			for (size_t i = 0; i < pos_ && i < text_.size(); i++)
+			{
+				if (text_[i] == '\n')
+					line++;
+			}
+
+			error_ = std::string(msg) + " at line " + std::to_string(line);
+			return false;
+		}
+
+		void JSONDocument::skipWhitespace()
+		{
+			while (pos_ < text_.size())
+			{
+				char ch = text_[pos_];
+				if (ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n')
+					break;
+				pos_++;
+			}
+		}
+
+		bool JSONDocument::parseLiteral(const char* word)
+		{
+			size_t len = std::strlen(word);
+			if (text_.compare(pos_, len, word) != 0)
+				return fail("invalid value");
+
+			pos_ += len;
+			return true;
+		}
+
+		bool JSONDocument::parseValue(Node& node, size_t depth)
+		{
+			if (pos_ >= text_.size())
+				return fail("unexpected end of document");
+
+			switch (text_[pos_])
+			{
+			case '{':
+				return parseContainer(node, true, depth);
+
+			case '[':
+				return parseContainer(node, false, depth);
+
+			case '"':
+				node.type_ = Type::String;
+				return parseString(node.first_, node.count_);
+
+			case 't':
+				node.type_ = Type::Bool;
+				node.number_ = 1.0;
+				return parseLiteral("true");
+
+			case 'f':
+				node.type_ = Type::Bool;
+				node.number_ = 0.0;
+				return parseLiteral("false");
+
+			case 'n':
+				node.type_ = Type::Null;
+				return parseLiteral("null");
+
+			default:
+				node.type_ = Type::Number;
+				return parseNumber(node.number_);
+			}
+		}
+
+		bool JSONDocument::parseContainer(Node& node, bool object, size_t depth)
+		{
+			char close = object ? '}' : ']';
+			size_t mark = stack_.size();
+
+			if (depth >= MaxDepth)
+				return fail("values are nested too deeply");
+
+			pos_++;
+			skipWhitespace();
+
+			if (pos_ < text_.size() && text_[pos_] == close)
+			{
+				pos_++;
+			}
+			else
+			{
+				while (true)
+				{
+					Node child = Node();
+
+					if (object)
+					{
+						if (pos_ >= text_.size() || text_[pos_] != '"')
+							return fail("expected a member name");
+
+						if (!parseString(child.keyoff_, child.keylen_))
+							return false;
+
+						skipWhitespace();
+						if (pos_ >= text_.size() || text_[pos_] != ':')
+							return fail("expected ':' after a member name");
+
+						pos_++;
+						skipWhitespace();
+					}
+
+					if (!parseValue(child, depth + 1))
+						return false;
+
+					stack_.push_back(child);
+
+					skipWhitespace();
+					if (pos_ >= text_.size())
+						return fail("unexpected end of document");
+
+					if (text_[pos_] == close)
+					{
+						pos_++;
+						break;
+					}
+
+					if (text_[pos_] != ',')
+						return fail(object ? "expected ',' or '}'" : "expected ',' or ']'");
+
+					pos_++;
+					skipWhitespace();
+				}
+			}
+
+			//
+			// The children are complete, move them from the work stack into the document
+			// so they sit next to each other
+			//
+			node.type_ = object ? Type::Object : Type::Array;
+			node.first_ = nodes_.size();
+			node.count_ = stack_.size() - mark;
+			nodes_.insert(nodes_.end(), stack_.begin() + mark, stack_.end());
+			stack_.resize(mark);
+
+			return true;
+		}
+
+		bool JSONDocument::readHex(unsigned long& v)
+		{
+			v = 0;
+			for (int i = 0; i < 4; i++)
+			{
+				if (pos_ >= text_.size())
+					return fail("unexpected end of document");
+
+				char ch = text_[pos_++];
+				v <<= 4;
+				if (ch >= '0' && ch <= '9')
+					v |= ch - '0';
+				else if (ch >= 'a' && ch <= 'f')
+					v |= ch - 'a' + 10;
+				else if (ch >= 'A' && ch <= 'F')
+					v |= ch - 'A' + 10;
+				else
+					return fail("invalid unicode escape");
+			}
+
+			return true;
+		}
+
+		void JSONDocument::putUtf8(size_t& out, unsigned long cp)
+		{
+			if (cp < 0x80)
+			{
+				text_[out++] = static_cast<char>(cp);
+			}
+			else if (cp < 0x800)
+			{
+				text_[out++] = static_cast<char>(0xC0 | (cp >> 6));
+				text_[out++] = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else if (cp < 0x10000)
+			{
+				text_[out++] = static_cast<char>(0xE0 | (cp >> 12));
+				text_[out++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				text_[out++] = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else
+			{
+				text_[out++] = static_cast<char>(0xF0 | (cp >> 18));
+				text_[out++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+				text_[out++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				text_[out++] = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+		}
+
+		bool JSONDocument::parseString(size_t& offset, size_t& length)
+		{
+			//
+			// Escapes always take more text than what they stand for, so the decoded string
+			// is written over the text it came from
+			//
+			pos_++;
+			offset = pos_;
+			size_t out = pos_;
+
+			while (true)
+			{
+				if (pos_ >= text_.size())
+					return fail("unterminated string");
+
+				char ch = text_[pos_++];
+				if (ch == '"')
+					break;
+
+				if (ch == '\\')
+				{
+					if (pos_ >= text_.size())
+						return fail("unterminated string");
+
+					ch = text_[pos_++];
+					switch (ch)
+					{
+					case '"':
+					case '\\':
+					case '/':
+						text_[out++] = ch;
+						break;
+					case 'b':
+						text_[out++] = '\b';
+						break;
+					case 'f':
+						text_[out++] = '\f';
+						break;
+					case 'n':
+						text_[out++] = '\n';
+						break;
+					case 'r':
+						text_[out++] = '\r';
+						break;
+					case 't':
+						text_[out++] = '\t';
+						break;
+					case 'u':
+					{
+						unsigned long cp;
+						if (!readHex(cp))
+							return false;
+
+						if (cp >= 0xD800 && cp < 0xDC00)
+						{
+							unsigned long low;
+							if (text_.compare(pos_, 2, "\\u") != 0)
+								return fail("invalid unicode escape");
+							pos_ += 2;
+							if (!readHex(low) || low < 0xDC00 || low >= 0xE000)
+								return fail("invalid unicode escape");
+							cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+						}
+						putUtf8(out, cp);
+						break;
+					}
+					default:
+						return fail("invalid escape in string");
+					}
+				}
+				else if (static_cast<unsigned char>(ch) < 0x20 && ch != '\t')
+				{
+					return fail("control character in string");
+				}
+				else
+				{
+					text_[out++] = ch;
+				}
+			}
+
+			length = out - offset;
+			return true;
+		}
+
+		bool JSONDocument::parseNumber(double& v)
+		{
+			size_t start = pos_;
+			size_t size = text_.size();
+
+			if (pos_ < size && text_[pos_] == '-')
+				pos_++;
+
+			if (pos_ >= size || text_[pos_] < '0' || text_[pos_] > '9')
+				return fail("invalid value");
+
+			while (pos_ < size && text_[pos_] >= '0' && text_[pos_] <= '9')
+				pos_++;
+
+			if (pos_ < size && text_[pos_] == '.')
+			{
+				pos_++;
+				if (pos_ >= size || text_[pos_] < '0' || text_[pos_] > '9')
+					return fail("invalid number");
+
+				while (pos_ < size && text_[pos_] >= '0' && text_[pos_] <= '9')
+					pos_++;
+			}
+
+			if (pos_ < size && (text_[pos_] == 'e' || text_[pos_] == 'E'))
+			{
+				pos_++;
+				if (pos_ < size && (text_[pos_] == '-' || text_[pos_] == '+'))
+					pos_++;
+
+				if (pos_ >= size || text_[pos_] < '0' || text_[pos_] > '9')
+					return fail("invalid number");
+
+				while (pos_ < size && text_[pos_] >= '0' && text_[pos_] <= '9')
+					pos_++;
+			}
+
+#if defined(__cpp_lib_to_chars)
+			const char* first = text_.data() + start;
+			const char* last = text_.data() + pos_;
+			std::from_chars_result result = std::from_chars(first, last, v);
+			if (result.ptr != last)
+				return fail("invalid number");
+
+			if (result.ec == std::errc::result_out_of_range)
+				v = std::strtod(text_.substr(start, pos_ - start).c_str(), nullptr);
+#else
+			std::string num = text_.substr(start, pos_ - start);
+			v = std::strtod(num.c_str(), nullptr);
+#endif
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace xero
+{
+	namespace paths
+	{
+		//
+		// A JSON document read from UTF-8 text.  The text is kept by the document and strings
+		// are decoded in place, and all of the values live in one array with the elements of
+		// each array or object stored next to each other, so reading a file allocates a
+		// handful of times rather than once per value.  Values are looked at through the
+		// small Value handle, which is only good while the document is.
+		//
+		class JSONDocument
+		{
+		public:
+			enum class Type
+			{
+				Missing,
+				Null,
+				Bool,
+				Number,
+				String,
+				Array,
+				Object
+			};
+
+		private:
+			struct Node
+			{
+				Type type_;
+				size_t keyoff_;
+				size_t keylen_;
+				double number_;
+				size_t first_;
+				size_t count_;
+			};
+
+		public:
+			class Value
+			{
+				friend class JSONDocument;
+
+			public:
+				Value() {
+					doc_ = nullptr;
+					index_ = 0;
+				}
+
+				Type type() const {
+					return doc_ == nullptr ? Type::Missing : node().type_;
+				}
+
+				bool isValid() const {
+					return doc_ != nullptr;
+				}
+
+				bool isNull() const {
+					return type() == Type::Null;
+				}
+
+				bool isBool() const {
+					return type() == Type::Bool;
+				}
+
+				bool isNumber() const {
+					return type() == Type::Number;
+				}
+
+				bool isString() const {
+					return type() == Type::String;
+				}
+
+				bool isArray() const {
+					return type() == Type::Array;
+				}
+
+				bool isObject() const {
+					return type() == Type::Object;
+				}
+
+				bool asBool() const {
+					return isBool() && node().number_ != 0.0;
+				}
+
+				double asNumber() const {
+					return isNumber() ? node().number_ : 0.0;
+				}
+
+				std::string asString() const;
+
+				//
+				// The number of elements in an array or members in an object
+				//
+				size_t size() const {
+					return (isArray() || isObject()) ? node().count_ : 0;
+				}
+
+				//
+				// An element of an array, or a member of an object in the order given in the text
+				//
+				Value operator[](size_t index) const;
+
+				Value operator[](int index) const {
+					return index < 0 ? Value() : (*this)[static_cast<size_t>(index)];
+				}
+
+				//
+				// The member of an object with the name given.  If there is no such member, or
+				// this is not an object, the value returned is not valid.  If a name appears more
+				// than once the last one is used.
+				//
+				Value operator[](const char* key) const;
+
+				bool contains(const char* key) const {
+					return (*this)[key].isValid();
+				}
+
+				//
+				// The name of a member of an object
+				//
+				std::string key() const;
+
+			private:
+				Value(const JSONDocument* doc, size_t index) {
+					doc_ = doc;
+					index_ = index;
+				}
+
+				const Node& node() const {
+					return doc_->nodes_[index_];
+				}
+
+			private:
+				const JSONDocument* doc_;
+				size_t index_;
+			};
+
+		public:
+			JSONDocument();
+
+			//
+			// Parse the text given, returns false and sets the error message if it is not valid JSON
+			//
+			bool parse(std::string text);
+
+			//
+			// Read a file and parse it, returns false if the file cannot be read or is not valid JSON
+			//
+			bool readFile(const std::string& filename);
+
+			Value root() const {
+				return nodes_.empty() ? Value() : Value(this, root_);
+			}
+
+			const std::string& error() const {
+				return error_;
+			}
+
+		private:
+			static constexpr size_t MaxDepth = 256;
+
+			bool parseValue(Node& node, size_t depth);
+			bool parseString(size_t& offset, size_t& length);
+			bool parseNumber(double& v);
+			bool parseContainer(Node& node, bool object, size_t depth);
+			bool parseLiteral(const char* word);
+			void skipWhitespace();
+			bool fail(const char* msg);
+			void putUtf8(size_t& out, unsigned long cp);
+			bool readHex(unsigned long& v);
+
+		private:
+			std::string text_;
+			size_t pos_;
+			std::vector<Node> nodes_;
+			std::vector<Node> stack_;
+			size_t root_;
+			std::string error_;
+		};
+	}
+}
@@ -0,0 +1,161 @@
+#include "JSONEmitter.h"
+#include <cmath>
+#include <cstdio>
+
+namespace xero
+{
+	namespace paths
+	{
+		JSONEmitter::JSONEmitter(std::ostream& strm, OutputBuffer& out, size_t flushsize) : strm_(strm), out_(out)
+		{
+			flushsize_ = flushsize;
+			afterkey_ = false;
+			out_.clear();
+		}
+
+		void JSONEmitter::indent(size_t depth)
+		{
+			for (size_t i = 0; i < depth; i++)
+				out_ << "    ";
+		}
+
+		void JSONEmitter::beforeValue()
+		{
+			if (afterkey_)
+			{
+				afterkey_ = false;
+				return;
+			}
+
+			if (!stack_.empty())
+			{
+				Level& level = stack_.back();
+				if (!level.empty_)
+					out_ << ",\n";
+				level.empty_ = false;
+				indent(stack_.size());
+			}
+		}
+
+		void JSONEmitter::beginObject()
+		{
+			beforeValue();
+			out_ << "{\n";
+			stack_.push_back({ true, true });
+		}
+
+		void JSONEmitter::endObject()
+		{
+			if (!stack_.back().empty_)
+				out_ << '\n';
+
+			stack_.pop_back();
+			indent(stack_.size());
+			out_ << '}';
+			flushIfFull();
+		}
+
+		void JSONEmitter::beginArray()
+		{
+			beforeValue();
+			out_ << "[\n";
+			stack_.push_back({ false, true });
+		}
+
+		void JSONEmitter::endArray()
+		{
+			if (!stack_.back().empty_)
+				out_ << '\n';
+
+			stack_.pop_back();
+			indent(stack_.size());
+			out_ << ']';
+			flushIfFull();
+		}
+
+		void JSONEmitter::key(const std::string& name)
+		{
+			beforeValue();
+			string(name);
+			out_ << ": ";
+			afterkey_ = true;
+		}
+
+		void JSONEmitter::value(double v)
+		{
+			beforeValue();
+			if (std::isfinite(v))
+				out_.appendNumber(v, NumberFormat::Shortest, 0);
+			else
+				out_ << "null";
+		}
+
+		void JSONEmitter::value(const std::string& str)
+		{
+			beforeValue();
+			string(str);
+		}
+
+		void JSONEmitter::string(const std::string& str)
+		{
+			out_ << '"';
+			for (char ch : str)
+			{
+				switch (ch)
+				{
+				case '"':
+					out_ << "\\\"";
+					break;
+				case '\\':
+					out_ << "\\\\";
+					break;
+				case '\b':
+					out_ << "\\b";
+					break;
+				case '\f':
+					out_ << "\\f";
+					break;
+				case '\n':
+					out_ << "\\n";
+					break;
+				case '\r':
+					out_ << "\\r";
+					break;
+				case '\t':
+					out_ << "\\t";
+					break;
+				default:
+					if (static_cast<unsigned char>(ch) < 0x20)
+					{
+						char text[8];
+						std::snprintf(text, sizeof(text), "\\u%04x", static_cast<unsigned char>(ch));
+						out_ << text;
+					}
+					else
+					{
+						out_ << ch;
+					}
+					break;
+				}
+			}
+			out_ << '"';
+		}
+
+		void JSONEmitter::flushIfFull()
+		{
+			if (out_.size() >= flushsize_)
+			{
+				out_.write(strm_);
+				out_.clear();
+			}
+		}
+
+		bool JSONEmitter::finish()
+		{
+			out_ << '\n';
+			bool ret = out_.write(strm_);
+			out_.clear();
+			return ret;
+		}
+	}
+}
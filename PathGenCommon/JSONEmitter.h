@@ -0,0 +1,65 @@
+#pragma once
+
+#include "OutputBuffer.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace xero
+{
+	namespace paths
+	{
+		//
+		// Writes a JSON document one value at a time, in the same indented layout the Qt
+		// JSON writer uses.  The text is formatted into an output buffer that is written to
+		// the stream each time it fills, so the memory used does not grow with the size of
+		// the document.  Members are written in the order given, so a caller that wants the
+		// sorted keys Qt produces must supply them sorted.
+		//
+		class JSONEmitter
+		{
+		public:
+			JSONEmitter(std::ostream& strm, OutputBuffer& out, size_t flushsize = 64 * 1024);
+
+			void beginObject();
+			void endObject();
+			void beginArray();
+			void endArray();
+
+			//
+			// Start an object member, the value that follows belongs to this key
+			//
+			void key(const std::string& name);
+
+			//
+			// Numbers that are not finite are written as null, which is what Qt does
+			//
+			void value(double v);
+			void value(const std::string& str);
+
+			//
+			// End the document and write anything left in the buffer to the stream
+			//
+			bool finish();
+
+		private:
+			void beforeValue();
+			void indent(size_t depth);
+			void string(const std::string& str);
+			void flushIfFull();
+
+		private:
+			struct Level
+			{
+				bool object_;
+				bool empty_;
+			};
+
+			std::ostream& strm_;
+			OutputBuffer& out_;
+			size_t flushsize_;
+			std::vector<Level> stack_;
+			bool afterkey_;
+		};
+	}
+}
@@ -1,9 +1,7 @@
 #include "JSONPathReader.h"
-#include "JSONPathReader.h"
-#include "JSON.h"
-#include "JSONValue.h"
 #include "DistanceVelocityConstraint.h"
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <cmath>
 
@@ -11,254 +9,230 @@ namespace xero
 {
 	namespace paths
 	{
-		std::wstring JSONPathReader::toWide(const std::string& str)
-		{
-			std::wstring result;
-
-			for (char ch : str)
-				result += (wchar_t)ch;
-
-			return result;
-		}
-
-		std::string JSONPathReader::toNarrow(const std::wstring& str)
-		{
-			std::string result;
-
-			for (wchar_t ch : str)
-				result += (char)ch;
-
-			return result;
-		}
-
-		bool JSONPathReader::readFile(const std::string& filename, std::wstring& data)
+		bool JSONPathReader::readFile(const std::string& filename, std::string& data)
 		{
-			std::string line;
-
-			std::ifstream strm(filename);
+			std::ifstream strm(filename, std::ios::binary);
 			if (!strm.is_open()) 
 			{
 				std::cerr << "pathgen: cannot open path file '" << filename << "'' for reading" << std::endl;
 				return false;
 			}
 
-			while (getline(strm, line))
-			{
-				data += toWide(line);
-				data += (wchar_t)'\n';
-			}
+			std::stringstream text;
+			text << strm.rdbuf();
+			data = text.str();
 
 			return true;
 		}
 
 		bool JSONPathReader::readJSONRobotFile(const std::string& filename, RobotParams& robot)
 		{
-			std::wstring data;
+			std::string data;
+			JSONDocument doc;
 
 			if (!readFile(filename, data))
 				return false;
 
-			JSONValue* value = JSON::Parse(data.c_str());
-			if (value == nullptr)
+			if (!doc.parse(std::move(data)))
 			{
 				std::cerr << "pathgen: cannot parse file '" << filename << "' as a robot file" << std::endl;
+				std::cerr << "         " << doc.error() << std::endl;
 				return false;
 			}
 
-			if (!value->IsObject())
+			JSONDocument::Value root = doc.root();
+			if (!root.isObject())
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         top level entity in file is not a JSON object" << std::endl;
 				return false;
 			}
 
-			JSONObject root = value->AsObject();
-
-			if (root.find(RobotParams::NameTagW) == root.end())
+			if (!root.contains(RobotParams::NameTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'name' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::NameTagW]->IsString())
+			if (!root[RobotParams::NameTag].isString())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'name' field is not a string" << std::endl;
 				return false;
 			}
-			robot.setName(toNarrow(root[RobotParams::NameTagW]->AsString()));
+			robot.setName(root[RobotParams::NameTag].asString());
 
-			if (root.find(RobotParams::DriveTypeTagW) == root.end())
+			if (!root.contains(RobotParams::DriveTypeTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'drivetype' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::DriveTypeTagW]->IsNumber())
+			if (!root[RobotParams::DriveTypeTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'drivetype' field is not a number" << std::endl;
 				return false;
 			}
-			int dt = static_cast<int>(root[RobotParams::DriveTypeTagW]->AsNumber());
+			int dt = static_cast<int>(root[RobotParams::DriveTypeTag].asNumber());
 			robot.setDriveType(static_cast<RobotParams::DriveType>(dt));
 
-			if (root.find(RobotParams::TimeStepTagW) == root.end())
+			if (!root.contains(RobotParams::TimeStepTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'timestep' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::TimeStepTagW]->IsNumber())
+			if (!root[RobotParams::TimeStepTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'timestep' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setTimestep(root[RobotParams::TimeStepTagW]->AsNumber());
+			robot.setTimestep(root[RobotParams::TimeStepTag].asNumber());
 
-			if (root.find(RobotParams::EffectiveLengthTagW) == root.end())
+			if (!root.contains(RobotParams::EffectiveLengthTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object does not contain 'efflength' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::EffectiveLengthTagW]->IsNumber())
+			if (!root[RobotParams::EffectiveLengthTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'efflength' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setEffectiveLength(root[RobotParams::EffectiveLengthTagW]->AsNumber());
+			robot.setEffectiveLength(root[RobotParams::EffectiveLengthTag].asNumber());
 
-			if (root.find(RobotParams::EffectiveWidthTagW) == root.end())
+			if (!root.contains(RobotParams::EffectiveWidthTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object does not contain 'effwidth' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::EffectiveWidthTagW]->IsNumber())
+			if (!root[RobotParams::EffectiveWidthTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'effwidth' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setEffectiveWidth(root[RobotParams::EffectiveWidthTagW]->AsNumber());
+			robot.setEffectiveWidth(root[RobotParams::EffectiveWidthTag].asNumber());
 
-			if (root.find(RobotParams::RobotLengthTagW) == root.end())
+			if (!root.contains(RobotParams::RobotLengthTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object does not contain 'robotlength' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::RobotLengthTagW]->IsNumber())
+			if (!root[RobotParams::RobotLengthTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'robotlength' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setRobotLength(root[RobotParams::RobotLengthTagW]->AsNumber());
+			robot.setRobotLength(root[RobotParams::RobotLengthTag].asNumber());
 
-			if (root.find(RobotParams::RobotWidthTagW) == root.end())
+			if (!root.contains(RobotParams::RobotWidthTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object does not contain 'robotwidth' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::RobotWidthTagW]->IsNumber())
+			if (!root[RobotParams::RobotWidthTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'robotwidth' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setRobotWidth(root[RobotParams::RobotWidthTagW]->AsNumber());
+			robot.setRobotWidth(root[RobotParams::RobotWidthTag].asNumber());
 
 
-			if (root.find(RobotParams::RobotWeightTagW) == root.end())
+			if (!root.contains(RobotParams::RobotWeightTag))
 			{
 				robot.setRobotWeight(180);
 			}
 			else
 			{
-				if (!root[RobotParams::RobotWeightTagW]->IsNumber())
+				if (!root[RobotParams::RobotWeightTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 					std::cerr << "         group object 'weight' field is not a number" << std::endl;
 					return false;
 				}
-				robot.setRobotWeight(root[RobotParams::RobotWeightTagW]->AsNumber());
+				robot.setRobotWeight(root[RobotParams::RobotWeightTag].asNumber());
 			}
 
-			if (root.find(RobotParams::MaxVelocityTagW) == root.end())
+			if (!root.contains(RobotParams::MaxVelocityTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'maxvelocity' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::MaxVelocityTagW]->IsNumber())
+			if (!root[RobotParams::MaxVelocityTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'maxvelocity' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setMaxVelocity(root[RobotParams::MaxVelocityTagW]->AsNumber());
+			robot.setMaxVelocity(root[RobotParams::MaxVelocityTag].asNumber());
 
-			if (root.find(RobotParams::MaxAccelerationTagW) == root.end())
+			if (!root.contains(RobotParams::MaxAccelerationTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'maxacceleration' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::MaxAccelerationTagW]->IsNumber())
+			if (!root[RobotParams::MaxAccelerationTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'maxacceleration' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setMaxAcceleration(root[RobotParams::MaxAccelerationTagW]->AsNumber());
+			robot.setMaxAcceleration(root[RobotParams::MaxAccelerationTag].asNumber());
 
-			if (root.find(RobotParams::MaxJerkTagW) == root.end())
+			if (!root.contains(RobotParams::MaxJerkTag))
 			{
 				std::cerr << "pathgen: robot file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'maxjerk' field" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotParams::MaxJerkTagW]->IsNumber())
+			if (!root[RobotParams::MaxJerkTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 				std::cerr << "         group object 'maxjerk' field is not a number" << std::endl;
 				return false;
 			}
-			robot.setMaxJerk(root[RobotParams::MaxJerkTagW]->AsNumber());
+			robot.setMaxJerk(root[RobotParams::MaxJerkTag].asNumber());
 
-			if (root.find(RobotParams::MaxCentripetalTagW) == root.end())
+			if (!root.contains(RobotParams::MaxCentripetalTag))
 			{
 				robot.setMaxCentripetalForce(100000000);
 			}
 			else
 			{
-				if (!root[RobotParams::MaxCentripetalTagW]->IsNumber())
+				if (!root[RobotParams::MaxCentripetalTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid robot file" << std::endl;
 					std::cerr << "         group object 'maxcentripetal' field is not a number" << std::endl;
 					return false;
 				}
-				robot.setMaxCentripetalForce(root[RobotParams::MaxCentripetalTagW]->AsNumber());
+				robot.setMaxCentripetalForce(root[RobotParams::MaxCentripetalTag].asNumber());
 			}
 
-			if (root.find(RobotParams::LengthUnitsTagW) != root.end())
+			if (root.contains(RobotParams::LengthUnitsTag))
 			{
-				robot.setLengthUnits(toNarrow(root[RobotParams::LengthUnitsTagW]->AsString()));
+				robot.setLengthUnits(root[RobotParams::LengthUnitsTag].asString());
 			}
 
 
@@ -267,43 +241,43 @@ namespace xero
 
 		bool JSONPathReader::readJSONPathFile(const std::string& filename, const RobotParams& robot, PathCollection& paths)
 		{
-			std::wstring data;
+			std::string data;
+			JSONDocument doc;
 			bool ret = true;
 
 			if (!readFile(filename, data))
 				return false;
 
-			JSONValue* value = JSON::Parse(data.c_str());
-			if (value == nullptr) 
+			if (!doc.parse(std::move(data)))
 			{
 				std::cerr << "pathgen: cannot parse file '" << filename << "' as a JSON file" << std::endl;
+				std::cerr << "         " << doc.error() << std::endl;
 				return false;
 			}
 
-			if (!value->IsObject()) 
+			JSONDocument::Value root = doc.root();
+			if (!root.isObject()) 
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         top level entity in file is not a JSON object" << std::endl;
 				return false;
 			}
 
-			JSONObject root = value->AsObject();
-
-			if (root.find(RobotPath::GroupsTagW) == root.end())
+			if (!root.contains(RobotPath::GroupsTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         top level object in file does not contains the entry 'groups'" << std::endl;
 				return false;
 			}
 
-			if (!root[RobotPath::GroupsTagW]->IsArray())
+			if (!root[RobotPath::GroupsTag].isArray())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         the 'groups' entry in top level object is not an JSON array" << std::endl;
 				return false;
 			}
 
-			JSONArray groups = root[RobotPath::GroupsTagW]->AsArray();
+			JSONDocument::Value groups = root[RobotPath::GroupsTag];
 			for (size_t i = 0; i < groups.size(); i++)
 			{
 				if (!parseGroup(filename, robot, paths, groups[i]))
@@ -313,54 +287,52 @@ namespace xero
 			return ret;
 		}
 
-		bool JSONPathReader::parseGroup(const std::string& filename, const RobotParams& robot, PathCollection& paths, JSONValue* obj)
+		bool JSONPathReader::parseGroup(const std::string& filename, const RobotParams& robot, PathCollection& paths, const JSONDocument::Value& group)
 		{
 			std::string name;
 			bool ret = true;
 
-			if (!obj->IsObject())
+			if (!group.isObject())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         an element of the 'groups' entry is not an object" << std::endl;
 				return false;
 			}
 
-			JSONObject group = obj->AsObject();
-
-			if (group.find(RobotPath::NameTagW) == group.end())
+			if (!group.contains(RobotPath::NameTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'name' field" << std::endl;
 				return false;
 			}
 
-			if (!group[RobotPath::NameTagW]->IsString())
+			if (!group[RobotPath::NameTag].isString())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object 'name' field is not a string" << std::endl;
 				return false;
 			}
 
-			name = toNarrow(group[RobotPath::NameTagW]->AsString());
+			name = group[RobotPath::NameTag].asString();
 
-			if (group.find(RobotPath::PathsTagW)== group.end())
+			if (!group.contains(RobotPath::PathsTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object does not contain 'paths' field" << std::endl;
 				return false;
 			}
 
-			if (!group[RobotPath::PathsTagW]->IsArray())
+			if (!group[RobotPath::PathsTag].isArray())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         group object 'paths' field is not an array" << std::endl;
 				return false;
 			}
 
-			JSONArray parray = group[RobotPath::PathsTagW]->AsArray();
+			JSONDocument::Value parray = group[RobotPath::PathsTag];
 			for (size_t i = 0; i < parray.size(); i++)
 			{
-				JSONValue* path = parray[i];
+				JSONDocument::Value path = parray[i];
 				if (!parsePath(filename, robot, paths, name, path))
 					ret = false;
 			}
@@ -368,93 +340,91 @@ namespace xero
 			return ret;
 		}
 
-		bool JSONPathReader::parseConstraints(const std::string& filename, JSONObject &path, std::shared_ptr<RobotPath> onepath)
+		bool JSONPathReader::parseConstraints(const std::string& filename, const JSONDocument::Value& path, std::shared_ptr<RobotPath> onepath)
 		{
-			if (!path[RobotPath::ConstraintsTagW]->IsArray())
+			if (!path[RobotPath::ConstraintsTag].isArray())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path object 'constraints' field is not an array" << std::endl;
 				return false;
 			}
 
-			JSONArray conarr = path[RobotPath::ConstraintsTagW]->AsArray();
+			JSONDocument::Value conarr = path[RobotPath::ConstraintsTag];
 			for (size_t i = 0; i < conarr.size(); i++)
 			{
-				JSONValue* conobj = conarr[i];
-				if (!conobj->IsObject())
+				JSONDocument::Value constr = conarr[i];
+				if (!constr.isObject())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         path object 'constraints' array element is not an object" << std::endl;
 					return false;
 				}
 
-				JSONObject constr = conobj->AsObject();
-
-				if (constr.find(RobotPath::TypeTagW) == constr.end())
+				if (!constr.contains(RobotPath::TypeTag))
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         path object constraint does not contain 'type' field" << std::endl;
 					return false;
 				}
 
-				if (!constr[RobotPath::TypeTagW]->IsString())
+				if (!constr[RobotPath::TypeTag].isString())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         path object constraint has 'type' field but it is not a string" << std::endl;
 					return false;
 				}
 
-				std::string type = toNarrow(constr[RobotPath::TypeTagW]->AsString());
+				std::string type = constr[RobotPath::TypeTag].asString();
 
 				if (type == RobotPath::DistanceVelocityTag)
 				{
 					double before, after;
 					double velocity;
 
-					if (constr.find(RobotPath::BeforeTagW) == constr.end())
+					if (!constr.contains(RobotPath::BeforeTag))
 					{
 						std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 						std::cerr << "         constraint 'distance_velocity' missing 'before' field" << std::endl;
 						return false;
 					}
 
-					if (!constr[RobotPath::BeforeTagW]->IsNumber())
+					if (!constr[RobotPath::BeforeTag].isNumber())
 					{
 						std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 						std::cerr << "         constraint 'distance_velocity' has 'before' field that is not a number" << std::endl;
 						return false;
 					}
-					before = constr[RobotPath::BeforeTagW]->AsNumber();
+					before = constr[RobotPath::BeforeTag].asNumber();
 
-					if (constr.find(RobotPath::AfterTagW) == constr.end())
+					if (!constr.contains(RobotPath::AfterTag))
 					{
 						std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 						std::cerr << "         constraint 'distance_velocity' missing 'after' field" << std::endl;
 						return false;
 					}
 
-					if (!constr[RobotPath::AfterTagW]->IsNumber())
+					if (!constr[RobotPath::AfterTag].isNumber())
 					{
 						std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 						std::cerr << "         constraint 'distance_velocity' has 'after' field that is not a number" << std::endl;
 						return false;
 					}
-					after = constr[RobotPath::AfterTagW]->AsNumber();
+					after = constr[RobotPath::AfterTag].asNumber();
 
-					if (constr.find(RobotPath::VelocityTagW) == constr.end())
+					if (!constr.contains(RobotPath::VelocityTag))
 					{
 						std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 						std::cerr << "         constraint 'distance_velocity' missing 'velocity' field" << std::endl;
 						return false;
 					}
 
-					if (!constr[RobotPath::VelocityTagW]->IsNumber())
+					if (!constr[RobotPath::VelocityTag].isNumber())
 					{
 						std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 						std::cerr << "         constraint 'distance_velocity' has 'velocity' field that is not a number" << std::endl;
 						return false;
 					}
-					velocity = constr[RobotPath::VelocityTagW]->AsNumber();
+					velocity = constr[RobotPath::VelocityTag].asNumber();
 					onepath->addTimingConstraint(std::make_shared<DistanceVelocityConstraint>(after, before, velocity));
 				}
 				else
@@ -468,156 +438,152 @@ namespace xero
 			return true;
 		}
 
-		bool JSONPathReader::parseFlags(const std::string& filename, JSONObject& path, std::shared_ptr<RobotPath> onepath)
+		bool JSONPathReader::parseFlags(const std::string& filename, const JSONDocument::Value& path, std::shared_ptr<RobotPath> onepath)
 		{
-			if (!path[RobotPath::FlagsTagW]->IsArray())
+			if (!path[RobotPath::FlagsTag].isArray())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path object 'flags' field is not an array" << std::endl;
 				return false;
 			}
 
-			JSONArray flagarr = path[RobotPath::FlagsTagW]->AsArray();
+			JSONDocument::Value flagarr = path[RobotPath::FlagsTag];
 			for (size_t i = 0; i < flagarr.size(); i++)
 			{
-				JSONValue* flagobj = flagarr[i];
-				if (!flagobj->IsObject())
+				JSONDocument::Value flagstr = flagarr[i];
+				if (!flagstr.isObject())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         path object 'flags' array element is not an object" << std::endl;
 					return false;
 				}
 
-				JSONObject flagstr = flagobj->AsObject();
-
 				double before, after;
 				std::string name;
 
-				if (flagstr.find(RobotPath::BeforeTagW) == flagstr.end())
+				if (!flagstr.contains(RobotPath::BeforeTag))
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         flag missing 'before' field" << std::endl;
 					return false;
 				}
 
-				if (!flagstr[RobotPath::BeforeTagW]->IsNumber())
+				if (!flagstr[RobotPath::BeforeTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         flag has 'before' field that is not a number" << std::endl;
 					return false;
 				}
-				before = flagstr[RobotPath::BeforeTagW]->AsNumber();
+				before = flagstr[RobotPath::BeforeTag].asNumber();
 
-				if (flagstr.find(RobotPath::AfterTagW) == flagstr.end())
+				if (!flagstr.contains(RobotPath::AfterTag))
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         flag missing 'after' field" << std::endl;
 					return false;
 				}
 
-				if (!flagstr[RobotPath::AfterTagW]->IsNumber())
+				if (!flagstr[RobotPath::AfterTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         flag has 'after' field that is not a number" << std::endl;
 					return false;
 				}
-				after = flagstr[RobotPath::AfterTagW]->AsNumber();
+				after = flagstr[RobotPath::AfterTag].asNumber();
 
-				if (flagstr.find(RobotPath::NameTagW) == flagstr.end())
+				if (!flagstr.contains(RobotPath::NameTag))
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         flag missing 'name' field" << std::endl;
 					return false;
 				}
 
-				if (!flagstr[RobotPath::NameTagW]->IsString())
+				if (!flagstr[RobotPath::NameTag].isString())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         flag has 'name' field that is not a string" << std::endl;
 					return false;
 				}
-				name = toNarrow(flagstr[RobotPath::NameTagW]->AsString());
+				name = flagstr[RobotPath::NameTag].asString();
 				onepath->addFlag(std::make_shared<PathFlag>(name, after, before));
 			}
 
 			return true;
 		}
 
-		bool JSONPathReader::parsePath(const std::string& filename, const RobotParams& robot, PathCollection& paths, const std::string& group, JSONValue* obj)
+		bool JSONPathReader::parsePath(const std::string& filename, const RobotParams& robot, PathCollection& paths, const std::string& group, const JSONDocument::Value& path)
 		{
 			std::string name;
 			std::vector<Pose2d> points;
 			std::shared_ptr<RobotPath> onepath;
 
-			if (!obj->IsObject())
+			if (!path.isObject())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         an element of the 'paths' entry in a 'group' is not an object" << std::endl;
 				return false;
 			}
 
-			JSONObject path = obj->AsObject();
-
-			if (path.find(RobotPath::NameTagW) == path.end())
+			if (!path.contains(RobotPath::NameTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path object does not contain 'name' field" << std::endl;
 				return false;
 			}
-			if (!path[RobotPath::NameTagW]->IsString())
+			if (!path[RobotPath::NameTag].isString())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path object 'name' field is not a string" << std::endl;
 				return false;
 			}
 
-			name = toNarrow(path[RobotPath::NameTagW]->AsString());
+			name = path[RobotPath::NameTag].asString();
 			onepath = paths.addPath(group, name);
 
-			if (path.find(RobotPath::StartVelocityTagW) == path.end())
+			if (!path.contains(RobotPath::StartVelocityTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path '" << name << "' is missing 'startvelocity' field" << std::endl;
 				return false;
 			}
 
-			if (!path[RobotPath::StartVelocityTagW]->IsNumber())
+			if (!path[RobotPath::StartVelocityTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path has 'startvelocity' field that is not a number" << std::endl;
 				return false;
 			}
-			onepath->setStartVelocity(path[RobotPath::StartVelocityTagW]->AsNumber());
+			onepath->setStartVelocity(path[RobotPath::StartVelocityTag].asNumber());
 
-			if (path.find(RobotPath::EndVelocityTagW) == path.end())
+			if (!path.contains(RobotPath::EndVelocityTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path is missing 'endvelocity' field" << std::endl;
 				return false;
 			}
 
-			if (!path[RobotPath::EndVelocityTagW]->IsNumber())
+			if (!path[RobotPath::EndVelocityTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path has 'endvelocity' field that is not a number" << std::endl;
 				return false;
 			}
-			onepath->setEndVelocity(path[RobotPath::EndVelocityTagW]->AsNumber());
+			onepath->setEndVelocity(path[RobotPath::EndVelocityTag].asNumber());
 
-			if (path.find(RobotPath::MaxVelocityTagW) == path.end())
+			if (!path.contains(RobotPath::MaxVelocityTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path is missing 'maxvelocity' field" << std::endl;
 				return false;
 			}
 
-			if (!path[RobotPath::MaxVelocityTagW]->IsNumber())
+			if (!path[RobotPath::MaxVelocityTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path has 'maxvelocity' field that is not a number" << std::endl;
 				return false;
 			}
-			double v = path[RobotPath::MaxVelocityTagW]->AsNumber();
+			double v = path[RobotPath::MaxVelocityTag].asNumber();
 			if (std::fabs(v) < 0.001 || v > robot.getMaxVelocity())
 			{
 				//
@@ -627,20 +593,20 @@ namespace xero
 			}
 			onepath->setMaxVelocity(v);
 
-			if (path.find(RobotPath::MaxAccelerationTagW) == path.end())
+			if (!path.contains(RobotPath::MaxAccelerationTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path is missing 'maxacceleration' field" << std::endl;
 				return false;
 			}
 
-			if (!path[RobotPath::MaxAccelerationTagW]->IsNumber())
+			if (!path[RobotPath::MaxAccelerationTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path has 'maxacceleration' field that is not a number" << std::endl;
 				return false;
 			}
-			v = path[RobotPath::MaxAccelerationTagW]->AsNumber();
+			v = path[RobotPath::MaxAccelerationTag].asNumber();
 			if (std::fabs(v) < 0.001 || v > robot.getMaxAccel()) 
 			{
 				//
@@ -650,20 +616,20 @@ namespace xero
 			}
 			onepath->setMaxAccel(v);
 
-			if (path.find(RobotPath::MaxJerkTagW) == path.end())
+			if (!path.contains(RobotPath::MaxJerkTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path is missing 'maxjerk' field" << std::endl;
 				return false;
 			}
 
-			if (!path[RobotPath::MaxJerkTagW]->IsNumber())
+			if (!path[RobotPath::MaxJerkTag].isNumber())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path has 'maxjerk' field that is not a number" << std::endl;
 				return false;
 			}
-			v = path[RobotPath::MaxJerkTagW]->AsNumber();
+			v = path[RobotPath::MaxJerkTag].asNumber();
 			if (std::fabs(v) < 0.001)
 			{
 				//
@@ -673,19 +639,19 @@ namespace xero
 			}
 			onepath->setMaxJerk(v);
 
-			if (path.find(RobotPath::MaxCentripetalTagW) == path.end())
+			if (!path.contains(RobotPath::MaxCentripetalTag))
 			{
 				v = robot.getMaxCentripetalForce();
 			}
 			else
 			{
-				if (!path[RobotPath::MaxCentripetalTagW]->IsNumber())
+				if (!path[RobotPath::MaxCentripetalTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         path has 'maxcentripetal' field that is not a number" << std::endl;
 					return false;
 				}
-				v = path[RobotPath::MaxCentripetalTagW]->AsNumber();
+				v = path[RobotPath::MaxCentripetalTag].asNumber();
 				if (std::fabs(v) < 0.001)
 				{
 					//
@@ -696,91 +662,89 @@ namespace xero
 			}
 			onepath->setMaxCentripetal(v);
 
-			if (path.find(RobotPath::ConstraintsTagW) != path.end() && !path[RobotPath::ConstraintsTagW]->IsNull())
+			if (path.contains(RobotPath::ConstraintsTag) && !path[RobotPath::ConstraintsTag].isNull())
 			{
 				if (!parseConstraints(filename, path, onepath))
 					return false;
 			}
 
-			if (path.find(RobotPath::FlagsTagW) != path.end() && !path[RobotPath::FlagsTagW]->IsNull())
+			if (path.contains(RobotPath::FlagsTag) && !path[RobotPath::FlagsTag].isNull())
 			{
 				if (!parseFlags(filename, path, onepath))
 					return false;
 			}
 
-			if (path.find(RobotPath::PointsTagW) == path.end())
+			if (!path.contains(RobotPath::PointsTag))
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path does not contain 'points' field" << std::endl;
 				return false;
 			}
 
-			if (!path[RobotPath::PointsTagW]->IsArray())
+			if (!path[RobotPath::PointsTag].isArray())
 			{
 				std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 				std::cerr << "         path contains 'point' field but it is not an array" << std::endl;
 				return false;
 			}
 
-			JSONArray ptarr = path[RobotPath::PointsTagW]->AsArray();
+			JSONDocument::Value ptarr = path[RobotPath::PointsTag];
 			for (size_t i = 0; i < ptarr.size(); i++)
 			{
-				JSONValue* vt = ptarr[i];
-				if (!vt->IsObject())
+				JSONDocument::Value pt = ptarr[i];
+				if (!pt.isObject())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         element in points array is not an object" << std::endl;
 					return false;
 				}
-
-				JSONObject pt = vt->AsObject();
 				double x, y;
 				double heading;
 
-				if (pt.find(RobotPath::XTagW) == pt.end())
+				if (!pt.contains(RobotPath::XTag))
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         point missing 'x' field" << std::endl;
 					return false;
 				}
 
-				if (!pt[RobotPath::XTagW]->IsNumber())
+				if (!pt[RobotPath::XTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         point has 'x' field that is not a number" << std::endl;
 					return false;
 				}
-				x = pt[RobotPath::XTagW]->AsNumber();
+				x = pt[RobotPath::XTag].asNumber();
 
-				if (pt.find(RobotPath::YTagW) == pt.end())
+				if (!pt.contains(RobotPath::YTag))
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         point missing 'y' field" << std::endl;
 					return false;
 				}
 
-				if (!pt[RobotPath::YTagW]->IsNumber())
+				if (!pt[RobotPath::YTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         point has 'y' field that is not a number" << std::endl;
 					return false;
 				}
-				y = pt[RobotPath::YTagW]->AsNumber();
+				y = pt[RobotPath::YTag].asNumber();
 
-				if (pt.find(RobotPath::HeadingTagW) == pt.end())
+				if (!pt.contains(RobotPath::HeadingTag))
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         point missing 'heading' field" << std::endl;
 					return false;
 				}
 
-				if (!pt[RobotPath::HeadingTagW]->IsNumber())
+				if (!pt[RobotPath::HeadingTag].isNumber())
 				{
 					std::cerr << "pathgen: file '" << filename << "' is not a valid path file" << std::endl;
 					std::cerr << "         point has 'heading' field that is not a number" << std::endl;
 					return false;
 				}
-				heading = pt[RobotPath::HeadingTagW]->AsNumber();
+				heading = pt[RobotPath::HeadingTag].asNumber();
 
 				Rotation2d rot = Rotation2d::fromDegrees(heading);
 				Translation2d trans(x, y);
@@ -0,0 +1,69 @@
+#include "OutputBuffer.h"
+#include <charconv>
+#include <cstdio>
+
+namespace xero
+{
+	namespace paths
+	{
+		void OutputBuffer::appendNumber(double v, NumberFormat fmt, int precision)
+		{
+			char text[512];
+			size_t len = 0;
+
+#if defined(__cpp_lib_to_chars)
+			std::to_chars_result result;
+
+			switch (fmt)
+			{
+			case NumberFormat::Shortest:
+				result = std::to_chars(text, text + sizeof(text), v);
+				break;
+			case NumberFormat::Fixed:
+				result = std::to_chars(text, text + sizeof(text), v, std::chars_format::fixed, precision);
+				break;
+			default:
+				result = std::to_chars(text, text + sizeof(text), v, std::chars_format::general, precision);
+				break;
+			}
+
+			if (result.ec == std::errc())
+				len = result.ptr - text;
+			else
+				len = std::to_chars(text, text + sizeof(text), v).ptr - text;
+#else
+			//
+			// No floating point to_chars in this library, use printf style formatting.  Seventeen
+			// significant digits always reads back as the same double, even if it is not the shortest.
+			//
+			int n;
+
+			switch (fmt)
+			{
+			case NumberFormat::Shortest:
+				n = std::snprintf(text, sizeof(text), "%.17g", v);
+				break;
+			case NumberFormat::Fixed:
+				n = std::snprintf(text, sizeof(text), "%.*f", precision, v);
+				break;
+			default:
+				n = std::snprintf(text, sizeof(text), "%.*g", precision, v);
+				break;
+			}
+
+			if (n < 0 || n >= static_cast<int>(sizeof(text)))
+				n = std::snprintf(text, sizeof(text), "%.17g", v);
+
+			len = static_cast<size_t>(n);
+#endif
+
+			buffer_.append(text, len);
+		}
+
+		OutputBuffer& OutputBuffer::local()
+		{
+			static thread_local OutputBuffer buffer;
+			return buffer;
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <ostream>
+
+namespace xero
+{
+	namespace paths
+	{
+		//
+		// How numbers are written to an output buffer
+		//
+		enum class NumberFormat
+		{
+			General,			// %g style with the given number of significant digits, like the iostream default
+			Shortest,			// The shortest text that reads back as the same double
+			Fixed				// A fixed number of digits after the decimal point
+		};
+
+		//
+		// A text buffer the trajectory writers format into before writing the whole file
+		// with one call, rather than pushing each value and line through an iostream.
+		//
+		class OutputBuffer
+		{
+		public:
+			OutputBuffer() {
+				format_ = NumberFormat::General;
+				precision_ = 6;
+			}
+
+			void setNumberFormat(NumberFormat fmt, int precision = 6) {
+				format_ = fmt;
+				precision_ = precision;
+			}
+
+			NumberFormat numberFormat() const {
+				return format_;
+			}
+
+			int precision() const {
+				return precision_;
+			}
+
+			void clear() {
+				buffer_.clear();
+			}
+
+			void reserve(size_t n) {
+				buffer_.reserve(n);
+			}
+
+			size_t size() const {
+				return buffer_.size();
+			}
+
+			const std::string& str() const {
+				return buffer_;
+			}
+
+			OutputBuffer& operator<<(double v) {
+				appendNumber(v, format_, precision_);
+				return *this;
+			}
+
+			OutputBuffer& operator<<(char ch) {
+				buffer_ += ch;
+				return *this;
+			}
+
+			OutputBuffer& operator<<(const char* str) {
+				buffer_ += str;
+				return *this;
+			}
+
+			OutputBuffer& operator<<(const std::string& str) {
+				buffer_ += str;
+				return *this;
+			}
+
+			void appendNumber(double v, NumberFormat fmt, int precision);
+
+			//
+			// Write the contents of the buffer to the stream given in one call
+			//
+			bool write(std::ostream& strm) const {
+				strm.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+				return !strm.fail();
+			}
+
+			//
+			// A buffer for the calling thread.  It keeps its memory between uses so
+			// writing many files does not allocate for each one.  The number format set
+			// on this buffer is the one the writers use.
+			//
+			static OutputBuffer& local();
+
+		private:
+			std::string buffer_;
+			NumberFormat format_;
+			int precision_;
+		};
+	}
+}
@@ -0,0 +1,77 @@
+#include "PathBatch.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace xero
+{
+	namespace paths
+	{
+		PathBatch::PathBatch(const PathCollection& coll)
+		{
+			for (std::shared_ptr<PathGroup> group : coll.getGroups())
+			{
+				for (size_t i = 0; i < group->size(); i++)
+					paths_.push_back(std::make_pair(group, group->getPathByIndex(i)));
+			}
+		}
+
+		size_t PathBatch::run(size_t threads, PathFunction fn)
+		{
+			std::atomic<size_t> next(0);
+
+			errors_.clear();
+
+			auto worker = [this, &next, &fn]() {
+				size_t index;
+
+				while ((index = next++) < paths_.size())
+				{
+					PathGroup& group = *paths_[index].first;
+					RobotPath& path = *paths_[index].second;
+
+					try {
+						fn(group, path);
+					}
+					catch (const std::exception& ex)
+					{
+						std::lock_guard<std::mutex> guard(errors_lock_);
+						errors_.push_back(group.getName() + "/" + path.getName() + ": " + ex.what());
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> guard(errors_lock_);
+						errors_.push_back(group.getName() + "/" + path.getName() + ": unknown error");
+					}
+				}
+			};
+
+			threads = std::max(static_cast<size_t>(1), std::min(threads, paths_.size()));
+
+			//
+			// The calling thread is one of the workers, a single path needs no other threads
+			//
+			std::vector<std::thread> pool;
+			for (size_t i = 1; i < threads; i++)
+				pool.push_back(std::thread(worker));
+
+			worker();
+
+			for (std::thread& t : pool)
+				t.join();
+
+			return errors_.size();
+		}
+
+		std::string PathBatch::outputFile(const std::string& dir, const PathGroup& group, const RobotPath& path, const std::string& ext)
+		{
+			return dir + "/" + group.getName() + "_" + path.getName() + ext;
+		}
+
+		size_t PathBatch::defaultThreads()
+		{
+			return std::max(1u, std::thread::hardware_concurrency());
+		}
+	}
+}
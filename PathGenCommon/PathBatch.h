@@ -0,0 +1,73 @@
+#pragma once
+
+#include "PathCollection.h"
+#include "PathGroup.h"
+#include "RobotPath.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xero
+{
+	namespace paths
+	{
+		//
+		// Runs a function for each path in a path collection on a set of threads, so a
+		// generator program given a whole path file reads the robot and sets up once and
+		// uses every core for the paths.
+		//
+		class PathBatch
+		{
+		public:
+			typedef std::function<void(PathGroup& group, RobotPath& path)> PathFunction;
+
+		public:
+			PathBatch(const PathCollection& coll);
+
+			size_t size() const {
+				return paths_.size();
+			}
+
+			//
+			// Call the function for each path, using up to the given number of threads, and
+			// return when all paths are done.  A path whose function throws an exception is
+			// a failure, the other paths are still run.  Returns the number of failures.
+			//
+			size_t run(size_t threads, PathFunction fn);
+
+			//
+			// The errors from the last run, one for each path that failed
+			//
+			const std::vector<std::string>& errors() const {
+				return errors_;
+			}
+
+			//
+			// Held while writing to the console so the lines for paths run at the same time
+			// are not mixed together
+			//
+			std::mutex& consoleLock() {
+				return console_lock_;
+			}
+
+			//
+			// The name of the output file for a path in an output directory
+			//
+			static std::string outputFile(const std::string& dir, const PathGroup& group, const RobotPath& path, const std::string& ext);
+
+			//
+			// The number of threads to use when none is given
+			//
+			static size_t defaultThreads();
+
+		private:
+			std::vector<std::pair<std::shared_ptr<PathGroup>, std::shared_ptr<RobotPath>>> paths_;
+			std::vector<std::string> errors_;
+			std::mutex console_lock_;
+			std::mutex errors_lock_;
+		};
+	}
+}
@@ -5,22 +5,125 @@ namespace xero
 {
 	namespace paths
 	{
+		void PathTrajectory::reserve(size_t n)
+		{
+			time_.reserve(n);
+			x_.reserve(n);
+			y_.reserve(n);
+			heading_.reserve(n);
+			cos_.reserve(n);
+			sin_.reserve(n);
+			position_.reserve(n);
+			velocity_.reserve(n);
+			acceleration_.reserve(n);
+			jerk_.reserve(n);
+			curvature_.reserve(n);
+			swrotation_.reserve(n);
+		}
+
+		void PathTrajectory::push_back(const Pose2dWithTrajectory& pt)
+		{
+			push_back(pt.time(), pt.x(), pt.y(), pt.rotation(), pt.position(), pt.velocity(), pt.acceleration(),
+				pt.jerk(), pt.curvature(), pt.swrotation());
+		}
+
+		void PathTrajectory::push_back(double time, double x, double y, const Rotation2d& rot, double pos, double vel,
+			double acc, double jerk, double cur, double swrot)
+		{
+			time_.push_back(time);
+			x_.push_back(x);
+			y_.push_back(y);
+			heading_.push_back(rot.toDegrees());
+			cos_.push_back(rot.getCos());
+			sin_.push_back(rot.getSin());
+			position_.push_back(pos);
+			velocity_.push_back(vel);
+			acceleration_.push_back(acc);
+			jerk_.push_back(jerk);
+			curvature_.push_back(cur);
+			swrotation_.push_back(swrot);
+		}
+
+		template<typename Traj>
+		auto PathTrajectory::findColumn(Traj& traj, TrajectoryColumn c) -> decltype(&traj.time_)
+		{
+			decltype(&traj.time_) ret = nullptr;
+
+			switch (c)
+			{
+			case TrajectoryColumn::Time:
+				ret = &traj.time_;
+				break;
+			case TrajectoryColumn::X:
+				ret = &traj.x_;
+				break;
+			case TrajectoryColumn::Y:
+				ret = &traj.y_;
+				break;
+			case TrajectoryColumn::Heading:
+				ret = &traj.heading_;
+				break;
+			case TrajectoryColumn::Position:
+				ret = &traj.position_;
+				break;
+			case TrajectoryColumn::Velocity:
+				ret = &traj.velocity_;
+				break;
+			case TrajectoryColumn::Acceleration:
+				ret = &traj.acceleration_;
+				break;
+			case TrajectoryColumn::Jerk:
+				ret = &traj.jerk_;
+				break;
+			case TrajectoryColumn::Curvature:
+				ret = &traj.curvature_;
+				break;
+			case TrajectoryColumn::Rotation:
+				ret = &traj.swrotation_;
+				break;
+			case TrajectoryColumn::Unknown:
+				break;
+			}
+
+			return ret;
+		}
+
+		double* PathTrajectory::columnData(TrajectoryColumn c)
+		{
+			if (c == TrajectoryColumn::Heading)
+				return nullptr;
+
+			std::vector<double>* col = findColumn(*this, c);
+			return col == nullptr ? nullptr : col->data();
+		}
+
+		std::vector<const std::vector<double>*> PathTrajectory::columns(const std::vector<std::string>& fields) const
+		{
+			std::vector<const std::vector<double>*> ret;
+
+			ret.reserve(fields.size());
+			for (const std::string& field : fields)
+				ret.push_back(findColumn(*this, Pose2dWithTrajectory::columnFromName(field)));
+
+			return ret;
+		}
+
 		size_t PathTrajectory::getIndex(double time)
 		{
 			if (size() == 0)
 				return std::numeric_limits<size_t>::max();
 
-			if (time < points_.front().time())
+			if (time < time_.front())
 				return std::numeric_limits<size_t>::max();
 
-			if (time > points_.back().time())
+			if (time > time_.back())
 				return std::numeric_limits<size_t>::max();
 
 			double delta = std::numeric_limits<double>::max();
 			size_t ret = 0;
 			for (size_t i = 0; i < size(); i++)
 			{
-				double dt = std::fabs(points_[i].time() - time);
+				double dt = std::fabs(time_[i] - time);
 				if (dt < delta)
 				{
 					delta = dt ;
@@ -39,9 +142,9 @@ namespace xero
 			if (dist < 0.0)
 				return false;
 
-			if (dist > points_.back().position())
+			if (dist > position_.back())
 			{
-				time = points_.back().time();
+				time = time_.back();
 				return true;
 			}
 
@@ -49,12 +152,12 @@ namespace xero
 			// Do a binary search to find the time for the distance given
 			//
 			size_t low = 0;
-			size_t high = points_.size() - 1;
+			size_t high = position_.size() - 1;
 
 			while (high - low > 1)
 			{
 				size_t mid = (high + low) / 2;
-				if (dist > points_[mid].position())
+				if (dist > position_[mid])
 				{
 					low = mid;
 				}
@@ -64,10 +167,8 @@ namespace xero
 				}
 			}
 
-			double pcnt = (dist - points_[low].position()) / (points_[high].position() - points_[low].position());
-			Pose2dWithTrajectory pt = points_[low].interpolate(points_[high], pcnt);
-
-			time = pt.time();
+			double pcnt = (dist - position_[low]) / (position_[high] - position_[low]);
+			time = (time_[high] - time_[low]) * pcnt + time_[low];
 			return true;
 		}
 	}
@@ -3,47 +3,196 @@
 #include "Pose2dWithTrajectory.h"
 #include <vector>
 #include <string>
+#include <iterator>
 
 namespace xero
 {
 	namespace paths
 	{
+		//
+		// A trajectory stored as columns, one contiguous array per value, so code that looks
+		// at one or two values across the whole trajectory only touches the memory it needs.
+		// The point oriented interface is still available, but each point is put together
+		// from the columns when it is asked for, so operator[] and the iterators return
+		// copies rather than references.
+		//
 		class PathTrajectory
 		{
 		public:
-			PathTrajectory(const std::string& name, const std::vector<Pose2dWithTrajectory>& pts) {
+			class const_iterator
+			{
+			public:
+				typedef std::input_iterator_tag iterator_category;
+				typedef Pose2dWithTrajectory value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const Pose2dWithTrajectory* pointer;
+				typedef Pose2dWithTrajectory reference;
+
+				const_iterator(const PathTrajectory* traj, size_t index) {
+					traj_ = traj;
+					index_ = index;
+				}
+
+				Pose2dWithTrajectory operator*() const {
+					return (*traj_)[index_];
+				}
+
+				const_iterator& operator++() {
+					index_++;
+					return *this;
+				}
+
+				const_iterator operator++(int) {
+					const_iterator ret = *this;
+					index_++;
+					return ret;
+				}
+
+				bool operator==(const const_iterator& other) const {
+					return traj_ == other.traj_ && index_ == other.index_;
+				}
+
+				bool operator!=(const const_iterator& other) const {
+					return !(*this == other);
+				}
+
+				const PathTrajectory* trajectory() const {
+					return traj_;
+				}
+
+				size_t index() const {
+					return index_;
+				}
+
+			private:
+				const PathTrajectory* traj_;
+				size_t index_;
+			};
+
+			typedef const_iterator iterator;
+
+		public:
+			PathTrajectory(const std::string& name) {
 				name_ = name;
-				points_ = pts;
 			}
-			typedef std::vector<Pose2dWithTrajectory>::iterator iterator;
-			typedef std::vector<Pose2dWithTrajectory>::const_iterator const_iterator;
 
-			iterator begin() {
-				return points_.begin();
+			PathTrajectory(const std::string& name, const std::vector<Pose2dWithTrajectory>& pts) {
+				name_ = name;
+				reserve(pts.size());
+				for (const Pose2dWithTrajectory& pt : pts)
+					push_back(pt);
 			}
 
-			iterator end() {
-				return points_.end();
+			PathTrajectory(const std::string& name, const PathTrajectory& other) : PathTrajectory(other) {
+				name_ = name;
 			}
 
 			const_iterator begin() const {
-				return points_.begin();
+				return const_iterator(this, 0);
 			}
 
 			const_iterator end() const {
-				return points_.end();
+				return const_iterator(this, size());
 			}
 
 			size_t size() const {
-				return points_.size();
+				return time_.size();
+			}
+
+			void reserve(size_t n);
+			void push_back(const Pose2dWithTrajectory& pt);
+			void push_back(double time, double x, double y, const Rotation2d& rot, double pos, double vel,
+				double acc, double jerk, double cur, double swrot);
+
+			Pose2dWithTrajectory operator[](size_t index) const {
+				return Pose2dWithTrajectory(pose(index), time_[index], position_[index], velocity_[index],
+					acceleration_[index], jerk_[index], curvature_[index], swrotation_[index]);
+			}
+
+			Pose2d pose(size_t index) const {
+				return Pose2d(translation(index), rotation(index));
+			}
+
+			Translation2d translation(size_t index) const {
+				return Translation2d(x_[index], y_[index]);
+			}
+
+			Rotation2d rotation(size_t index) const {
+				return Rotation2d(cos_[index], sin_[index], false);
+			}
+
+			//
+			// The columns, one entry per point.  The heading is in degrees, the cosine and
+			// sine of the heading are kept as well so the exact Rotation2d can be rebuilt.
+			//
+			const std::vector<double>& times() const {
+				return time_;
 			}
 
-			const Pose2dWithTrajectory& operator[](size_t index) const {
-				return points_[index];
+			const std::vector<double>& xs() const {
+				return x_;
 			}
 
-			Pose2dWithTrajectory& operator[](size_t index) {
-				return points_[index];
+			const std::vector<double>& ys() const {
+				return y_;
+			}
+
+			const std::vector<double>& headings() const {
+				return heading_;
+			}
+
+			const std::vector<double>& headingCos() const {
+				return cos_;
+			}
+
+			const std::vector<double>& headingSin() const {
+				return sin_;
+			}
+
+			const std::vector<double>& positions() const {
+				return position_;
+			}
+
+			const std::vector<double>& velocities() const {
+				return velocity_;
+			}
+
+			const std::vector<double>& accelerations() const {
+				return acceleration_;
+			}
+
+			const std::vector<double>& jerks() const {
+				return jerk_;
+			}
+
+			const std::vector<double>& curvatures() const {
+				return curvature_;
+			}
+
+			const std::vector<double>& swrotations() const {
+				return swrotation_;
+			}
+
+			//
+			// The columns for a set of field names, looked up once so writers can
+			// copy values without comparing names for every point
+			//
+			std::vector<const std::vector<double>*> columns(const std::vector<std::string>& fields) const;
+
+			//
+			// The column for a value to be written in place, or nullptr for TrajectoryColumn::Unknown.
+			// This is for code that computes a whole column at once, the number of points does not change.
+			// The heading is read only and gives nullptr, since rotation() is rebuilt from the cosine and
+			// sine kept with it and would not follow a change made here.
+			//
+			double* columnData(TrajectoryColumn c);
+
+			void setSwRotation(size_t index, double v) {
+				swrotation_[index] = v;
+			}
+
+			void setCurvature(size_t index, double v) {
+				curvature_[index] = v;
 			}
 
 			const std::string& name() const {
@@ -54,10 +203,28 @@ namespace xero
 
 			bool getTimeForDistance(double dist, double &time);
 
+		private:
+			//
+			// The column for a value, or nullptr for TrajectoryColumn::Unknown.  This is for
+			// columns() and columnData(), the vectors themselves are not handed out to be changed.
+			//
+			template<typename Traj>
+			static auto findColumn(Traj& traj, TrajectoryColumn c) -> decltype(&traj.time_);
+
 		private:
 			std::string name_;
-			std::vector<Pose2dWithTrajectory> points_;
+			std::vector<double> time_;
+			std::vector<double> x_;
+			std::vector<double> y_;
+			std::vector<double> heading_;
+			std::vector<double> cos_;
+			std::vector<double> sin_;
+			std::vector<double> position_;
+			std::vector<double> velocity_;
+			std::vector<double> acceleration_;
+			std::vector<double> jerk_;
+			std::vector<double> curvature_;
+			std::vector<double> swrotation_;
 		};
 	}
 }
-
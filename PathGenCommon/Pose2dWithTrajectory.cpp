@@ -18,49 +18,97 @@ namespace xero {
 			return Pose2dWithTrajectory(npose, ntime, npos, nvel, nacc, njerk, ncurvature, nrot);
 		}
 
-		double Pose2dWithTrajectory::getField(const std::string& field) const
+		TrajectoryColumn Pose2dWithTrajectory::columnFromName(const std::string& field)
 		{
-			double v = std::nan("");
+			TrajectoryColumn c = TrajectoryColumn::Unknown;
 
 			if (field == "x")
 			{
-				v = x();
+				c = TrajectoryColumn::X;
 			}
 			else if (field == "y")
 			{
-				v = y();
+				c = TrajectoryColumn::Y;
 			}
 			else if (field == "heading")
 			{
-				v = rotation().toDegrees();
+				c = TrajectoryColumn::Heading;
 			}
 			else if (field == "time")
 			{
-				v = time();
+				c = TrajectoryColumn::Time;
 			}
 			else if (field == "position")
 			{
-				v = position();
+				c = TrajectoryColumn::Position;
 			}
 			else if (field == "velocity")
 			{
-				v = velocity();
+				c = TrajectoryColumn::Velocity;
 			}
 			else if (field == "acceleration")
 			{
-				v = acceleration();
+				c = TrajectoryColumn::Acceleration;
 			}
 			else if (field == "jerk")
 			{
-				v = jerk();
+				c = TrajectoryColumn::Jerk;
 			}
 			else if (field == "curvature")
 			{
-				v = curvature();
+				c = TrajectoryColumn::Curvature;
 			}
 			else if (field == "rotation")
 			{
+				c = TrajectoryColumn::Rotation;
+			}
+
+			return c;
+		}
+
+		double Pose2dWithTrajectory::getField(const std::string& field) const
+		{
+			return getField(columnFromName(field));
+		}
+
+		double Pose2dWithTrajectory::getField(TrajectoryColumn column) const
+		{
+			double v = std::nan("");
+
+			switch (column)
+			{
+			case TrajectoryColumn::X:
+				v = x();
+				break;
+			case TrajectoryColumn::Y:
+				v = y();
+				break;
+			case TrajectoryColumn::Heading:
+				v = rotation().toDegrees();
+				break;
+			case TrajectoryColumn::Time:
+				v = time();
+				break;
+			case TrajectoryColumn::Position:
+				v = position();
+				break;
+			case TrajectoryColumn::Velocity:
+				v = velocity();
+				break;
+			case TrajectoryColumn::Acceleration:
+				v = acceleration();
+				break;
+			case TrajectoryColumn::Jerk:
+				v = jerk();
+				break;
+			case TrajectoryColumn::Curvature:
+				v = curvature();
+				break;
+			case TrajectoryColumn::Rotation:
 				v = swrotation();
+				break;
+			case TrajectoryColumn::Unknown:
+				break;
 			}
 
 			return v;
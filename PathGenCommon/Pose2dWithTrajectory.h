@@ -5,6 +5,25 @@ namespace xero
 {
 	namespace paths
 	{
+		//
+		// The values stored for each point on a trajectory, used to pick a value once
+		// rather than by name for every point
+		//
+		enum class TrajectoryColumn
+		{
+			Time,
+			X,
+			Y,
+			Heading,
+			Position,
+			Velocity,
+			Acceleration,
+			Jerk,
+			Curvature,
+			Rotation,
+			Unknown
+		};
+
 		class Pose2dWithTrajectory : public ICsv
 		{
 		public:
@@ -117,6 +136,9 @@ namespace xero
 			}
 
 			double getField(const std::string& field) const;
+			double getField(TrajectoryColumn column) const;
+
+			static TrajectoryColumn columnFromName(const std::string& field);
 
 			Pose2dWithTrajectory interpolate(const Pose2dWithTrajectory& other, double percent) const;
 
@@ -1,5 +1,4 @@
 #include "QuinticHermiteSpline.h"
-#include <cassert>
 
 namespace xero
 {
@@ -26,24 +25,27 @@ namespace xero
 			f_ = v0_;
 		}
 
-		double QuinticHermiteSpline::eval(double t)
+		//
+		// The polynomials are evaluated in Horner form, one multiply and add per coefficient
+		//
+		double QuinticHermiteSpline::eval(double t) const
 		{
-			return a() * t * t * t * t * t + b() * t * t * t * t + c() * t * t * t + d() * t * t + e() * t + f();
+			return ((((a_ * t + b_) * t + c_) * t + d_) * t + e_) * t + f_;
 		}
 
-		double QuinticHermiteSpline::derivative(double t)
+		double QuinticHermiteSpline::derivative(double t) const
 		{
-			return 5 * a() * t * t * t * t + 4 * b() * t * t * t + 3 * c() * t * t + 2 * d() * t + e();
+			return (((5 * a_ * t + 4 * b_) * t + 3 * c_) * t + 2 * d_) * t + e_;
 		}
 
-		double QuinticHermiteSpline::derivative2(double t)
+		double QuinticHermiteSpline::derivative2(double t) const
 		{
-			return 20 * a() * t * t * t + 12 * b() * t * t + 6 * c() * t + 2 * d();
+			return ((20 * a_ * t + 12 * b_) * t + 6 * c_) * t + 2 * d_;
 		}
 
-		double QuinticHermiteSpline::derivative3(double t)
+		double QuinticHermiteSpline::derivative3(double t) const
 		{
-			return 60 * a() * t * t + 24 * b() * t + 6 * c();
+			return (60 * a_ * t + 24 * b_) * t + 6 * c_;
 		}
 	}
 }
\ No newline at end of file
@@ -122,7 +122,7 @@ namespace xero
 
 			void clearSteps() {
 				for (auto& spline : splines_) {
-					spline->clearStep();
+					spline.clearStep();
 				}
 			}
 
@@ -404,7 +404,11 @@ namespace xero
 				return splines_.size() > 0;
 			}
 
-			const std::vector<std::shared_ptr<xero::paths::SplinePair>> &getSplines() {
+			const std::vector<xero::paths::SplinePair> &getSplines() const {
+				return splines_;
+			}
+
+			std::vector<xero::paths::SplinePair>& getSplines() {
 				return splines_;
 			}
 
@@ -450,7 +454,7 @@ namespace xero
 			}
 
 			bool getPoseAtTime(double time, Pose2dWithTrajectory& p2d);
-			std::shared_ptr<SplinePair> getSplineAtTime(double time);
+			const SplinePair* getSplineAtTime(double time) const;
 			bool getDistance(double time, double& value);
 			bool getHeading(double time, double& value);
 			bool getCurvature(double time, double& value);
@@ -460,21 +464,6 @@ namespace xero
 
 		private:
 			double optimize();
-			void runOptimizationIteration();
-			static double fitParabola(Translation2d p1, Translation2d p2, Translation2d p3);
-
-			struct ControlPoint {
-				ControlPoint() {
-					ddx = 0;
-					ddy = 0;
-				}
-				double ddx, ddy;
-			};
-
-			static constexpr int kMaxIterations = 100;
-			static constexpr double kMinDelta = 0.001;
-			static constexpr double kEpsilon = 1e-5;
-			static constexpr double kStepSize = 1.0;
 
 		private:
 			//
@@ -535,7 +524,7 @@ namespace xero
 			// path generation, because each path generator may have its own method for 
 			// computing the physical path.
 			//
-			std::vector<std::shared_ptr<xero::paths::SplinePair>> splines_;
+			std::vector<xero::paths::SplinePair> splines_;
 
 			//
 			// Used to lock access to the trajectory map
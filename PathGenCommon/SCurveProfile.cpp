@@ -1,10 +1,7 @@
 #include "SCurveProfile.h"
-#include "TrapezoidalProfile.h"
 #include <cmath>
 #include <cassert>
-#include <numeric>
 #include <stdexcept>
-#include <iostream>
 
 namespace xero
 {
@@ -15,11 +12,11 @@ namespace xero
 			assert(jerkmin < 0.0);
 			assert(accmin < 0.0);
 
-			t_ = std::vector<double>{ 0.0, std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan("") };
-			j_ = std::vector<double>{ jerkmax, 0.0, jerkmin, 0, jerkmin, 0, jerkmax, 0.0 };
-			a_ = std::vector<double>{ 0.0, accmax, accmax, 0.0, 0.0, accmin, accmin, 0.0 };
-			v_ = std::vector<double>{ 0.0, std::nan(""), std::nan(""), std::nan(""), velmax, std::nan(""), std::nan(""), std::nan("") };
-			p_ = std::vector<double>{ 0.0, std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan("") };
+			t_ = { 0.0, std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan("") };
+			j_ = { jerkmax, 0.0, jerkmin, 0, jerkmin, 0, jerkmax, 0.0 };
+			a_ = { 0.0, accmax, accmax, 0.0, 0.0, accmin, accmin, 0.0 };
+			v_ = { 0.0, std::nan(""), std::nan(""), std::nan(""), velmax, std::nan(""), std::nan(""), std::nan("") };
+			p_ = { 0.0, std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan(""), std::nan("") };
 
 			step_ = 0.01;
 
@@ -28,6 +25,7 @@ namespace xero
 			accmin_ = accmin;
 			accmax_ = accmax;
 			velmin_ = velmin;
+			velmax_ = velmax;
 			thresh_ = thresh;
 		}
 
@@ -49,9 +47,9 @@ namespace xero
 
 		bool SCurveProfile::update(double dist, double start_velocity, double end_velocity)
 		{
-			double high = v_[4];
+			double high = velmax_;
 			double low = velmin_;
-			double answer, mid;
+			double answer, v, highdist;
 
 			v_[0] = start_velocity;
 			v_[7] = end_velocity;
@@ -59,26 +57,43 @@ namespace xero
 			answer = high;
 			if (!tryOne(dist, answer))
 			{
+				highdist = p_[4];
 				if (!tryOne(dist, low))
 					throw std::runtime_error("jerk plus acceleration settings do not provide for solutions");
 
-				while (high - low > thresh_)
+				//
+				// Find the cruise velocity where the ramps up and down use the whole distance.  Newton's
+				// method is used from the high end, where the cruise distance is negative, since the
+				// ramp distance is convex in the velocity and the steps approach from above without
+				// overshooting.  When the step is less than the precision wanted, it is stretched to
+				// land just below the answer, and any step outside of the bracket is a bisection.
+				//
+				for (int i = 0; i < kMaxIterations && high - low > thresh_; i++)
 				{
-					mid = (high + low) / 2.0;
-					if (tryOne(dist, mid))
+					v = high + highdist / rampSlope(high);
+					if (high - v < thresh_ / 2.0)
+						v = high - thresh_ / 2.0;
+
+					if (!(v > low && v < high))
+						v = (high + low) / 2.0;
+
+					if (tryOne(dist, v))
 					{
-						answer = mid;
-						low = mid;
+						low = v;
 					}
 					else
 					{
-						answer = low;
-						high = mid;
+						high = v;
+						highdist = p_[4];
 					}
 				}
+
+				answer = low;
 			}
 
-			assert(tryOne(dist, answer) == true);
+			bool found = tryOne(dist, answer);
+			assert(found == true);
+			(void)found;
 
 			double timetotal = 0.0;
 			double disttotal = 0.0;
@@ -94,6 +109,72 @@ namespace xero
 			return true;
 		}
 
+		//
+		// The time spent in each part of a change in velocity, and the largest acceleration
+		// reached.  The acceleration ramps up at jerkup to acc, holds, and ramps back down to
+		// zero at jerkdown, or ramps up and right back down when there is not enough change in
+		// velocity to reach acc.  The peak has the sign of the change in velocity.
+		//
+		void SCurveProfile::rampTimes(double veldist, double jerkup, double jerkdown, double acc, double& tup, double& tconst, double& tdown, double& peak)
+		{
+			double dist = std::fabs(veldist);
+
+			tup = acc / jerkup;
+			tdown = -acc / jerkdown;
+
+			double dup = 0.5 * jerkup * tup * tup;
+			double ddown = acc * tdown + 0.5 * jerkdown * tdown * tdown;
+
+			if (tdown < 0.0 || dup + ddown > dist)
+			{
+				peak = std::sqrt(2.0 * dist * jerkup * jerkdown / (jerkdown - jerkup));
+				tup = peak / jerkup;
+				tdown = -peak / jerkdown;
+				tconst = 0.0;
+			}
+			else
+			{
+				peak = acc;
+				tconst = (dist - dup - ddown) / acc;
+			}
+
+			if (veldist < 0.0)
+				peak = -peak;
+		}
+
+		//
+		// The rate at which the distance covered by the ramps up and down grows with the
+		// cruise velocity
+		//
+		double SCurveProfile::rampSlope(double maxv) const
+		{
+			return rampSlope(maxv, v_[0], accmax_) + rampSlope(maxv, v_[7], -accmin_);
+		}
+
+		//
+		// For a ramp between the cruise velocity and another velocity.  Seen from the lower
+		// velocity, the acceleration ramps up at jerkmax and down at jerkmin in both cases.
+		//
+		double SCurveProfile::rampSlope(double maxv, double other, double acc) const
+		{
+			double jup = jerkmax_;
+			double jdown = -jerkmin_;
+			double k = 1.0 / jup + 1.0 / jdown;
+			double dv = std::fabs(maxv - other);
+			double sign = (maxv >= other) ? 1.0 : -1.0;
+
+			if (dv >= acc * acc * k / 2.0)
+				return sign * ((other + dv) / acc + acc / (2.0 * jdown));
+
+			//
+			// The acceleration does not reach its limit, with a peak acceleration of a the ramp
+			// covers other * k * a + c * a^3 and the velocity changes by k * a^2 / 2
+			//
+			double c = 1.0 / (6.0 * jup * jup) + 1.0 / (2.0 * jup * jdown) + 1.0 / (3.0 * jdown * jdown);
+			double a = std::sqrt(2.0 * dv / k);
+			return sign * (other * k + 3.0 * c * a * a) / (k * a);
+		}
+
 		//
 		// Go from start_velocity to to velmax_.  The acceleration
 		// will be a trapezoidal profile.
@@ -102,17 +183,11 @@ namespace xero
 		{
 			double dt;
 			double veldist = v_[4] - v_[0];
+			double apeak;
 
-			TrapezoidalProfile profile(jerkmax_, jerkmin_, accmax_);
-			profile.update(veldist, 0.0, 0.0);
-
-			t_[1] = profile.getTimeAccel();
-			t_[2] = profile.getTimeCruise() ;
-			t_[3] = profile.getTimeDecel() ;
-
-			double vpeak = profile.getActualMaxVelocity();
-			a_[1] = vpeak;
-			a_[2] = vpeak;
+			rampTimes(veldist, jerkmax_, jerkmin_, accmax_, t_[1], t_[2], t_[3], apeak);
+			a_[1] = apeak;
+			a_[2] = apeak;
 
 			for (size_t n = 1; n <= 3; n++)
 			{
@@ -126,23 +201,24 @@ namespace xero
 		{
 			double dt;
 			double veldist = -(v_[7] - v_[4]);
+			double apeak;
 
-			TrapezoidalProfile profile(-jerkmin_,-jerkmax_, -accmin_);
-			profile.update(veldist, 0.0, 0.0);
-
-			t_[5] = profile.getTimeAccel();
-			t_[6] = profile.getTimeCruise();
-			t_[7] = profile.getTimeDecel();
-
-			double vpeak = profile.getActualMaxVelocity();
-			a_[5] = -vpeak;
-			a_[6] = -vpeak;
+			rampTimes(veldist, -jerkmin_, -jerkmax_, -accmin_, t_[5], t_[6], t_[7], apeak);
+			a_[5] = -apeak;
+			a_[6] = -apeak;
 
 			for (size_t n = 5; n <= 7; n++)
 			{
 				dt = t_[n];
-				v_[n] = v_[n - 1] + a_[n - 1] * dt + 1.0 / 2.0 * j_[n - 1] * dt * dt;
 				p_[n] = v_[n - 1] * dt + a_[n - 1] * dt * dt / 2.0 + j_[n - 1] * dt * dt * dt / 6.0 ;
+
+				//
+				// The end velocity is the one asked for, and is kept as is.  Computing it again
+				// here would move it by rounding, and the next velocity tried would then ramp
+				// down to a slightly different velocity.
+				//
+				if (n < 7)
+					v_[n] = v_[n - 1] + a_[n - 1] * dt + 1.0 / 2.0 * j_[n - 1] * dt * dt;
 			}
 		}
 
@@ -192,13 +268,15 @@ namespace xero
 			assert(t >= 0.0);
 			assert(t <= t_[7] + kEpsilon);
 
-			for (size_t i = 1; i <= 7; i++)
-			{
-				if (t < t_[i])
-					return i;
-			}
+			//
+			// The times are in order, so the region is one past the number of region
+			// boundaries at or before t.  Counting avoids a branch for each boundary.
+			//
+			size_t region = 1;
+			for (size_t i = 1; i < 7; i++)
+				region += static_cast<size_t>(t_[i] <= t);
 
-			return t_.size() - 1;
+			return region;
 		}
 	}
 }
\ No newline at end of file
@@ -1,8 +1,9 @@
 #pragma once
 
 #include "SpeedProfileGenerator.h"
-#include <vector>
+#include <array>
 #include <cassert>
+#include <cstddef>
 
 namespace xero
 {
@@ -12,9 +13,13 @@ namespace xero
 		{
 		private:
 			static constexpr double kEpsilon = 1e-5;
+			static constexpr int kMaxIterations = 100;
 
 		public:
-			SCurveProfile(double jerkmax, double jerkmin, double accmax, double accmin, double velmax, double velmin, double thresh = 5.0);
+			/// \brief create a new profile
+			/// \param thresh the precision of the cruise velocity found when the distance
+			/// is too short to reach the maximum velocity
+			SCurveProfile(double jerkmax, double jerkmin, double accmax, double accmin, double velmax, double velmin, double thresh = 1e-6);
 
 			virtual ~SCurveProfile();
 
@@ -71,19 +76,24 @@ namespace xero
 			void rampDown();
 			size_t findRegion(double t) const ;
 			bool tryOne(double dist, double maxv);
+			double rampSlope(double maxv) const;
+			double rampSlope(double maxv, double other, double acc) const;
+
+			static void rampTimes(double veldist, double jerkup, double jerkdown, double acc, double& tup, double& tconst, double& tdown, double& peak);
 
 		private:
-			std::vector<double> j_;
-			std::vector<double> t_;
-			std::vector<double> a_;
-			std::vector<double> v_;
-			std::vector<double> p_;
+			std::array<double, 8> j_;
+			std::array<double, 8> t_;
+			std::array<double, 8> a_;
+			std::array<double, 8> v_;
+			std::array<double, 8> p_;
 
 			double jerkmax_;
 			double jerkmin_;
 			double accmin_;
 			double accmax_;
 			double velmin_;
+			double velmax_;
 			double thresh_;
 
 			double step_;
@@ -0,0 +1,173 @@
+#include "SplineOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace xero
+{
+	namespace paths
+	{
+		SplineOptimizer::SplineOptimizer()
+		{
+			max_iterations_ = kMaxIterations;
+			min_delta_ = kMinDelta;
+			iterations_ = 0;
+		}
+
+		SplineOptimizer::~SplineOptimizer()
+		{
+		}
+
+		size_t SplineOptimizer::capacity() const
+		{
+			return std::min({ costs_.capacity(), points_.capacity() + 1, end_.capacity() + 1, start_.capacity() + 1 });
+		}
+
+		double SplineOptimizer::optimize(std::vector<SplinePair>& splines)
+		{
+			double cost = evalCost(splines);
+
+			iterations_ = 0;
+			if (splines.size() < 2)
+				return cost;
+
+			while (iterations_ < max_iterations_)
+			{
+				double prev = cost;
+				if (!runIteration(splines, cost))
+					break;
+
+				iterations_++;
+				if (prev - cost < min_delta_)
+					break;
+			}
+
+			return cost;
+		}
+
+		double SplineOptimizer::evalCost(std::vector<SplinePair>& splines)
+		{
+			costs_.resize(splines.size());
+			for (size_t i = 0; i < splines.size(); i++)
+				costs_[i] = splines[i].sumDCurvature2();
+
+			return std::accumulate(costs_.begin(), costs_.end(), 0.0);
+		}
+
+		double SplineOptimizer::computeGradient(std::vector<SplinePair>& splines)
+		{
+			double magnitude = 0.0;
+
+			points_.assign(splines.size() - 1, ControlPoint());
+			end_.assign(splines.size() - 1, ControlPoint());
+			start_.assign(splines.size() - 1, ControlPoint());
+
+			for (size_t i = 0; i < splines.size() - 1; i++)
+			{
+				const SplinePair& spline = splines[i];
+				const SplinePair& splinenext = splines[i + 1];
+				if (spline.getStartPose().isColinear(splinenext.getStartPose()) || spline.getEndPose().isColinear(splinenext.getEndPose()))
+					continue;
+
+				ControlPoint& end = end_[i];
+				ControlPoint& start = start_[i];
+				ControlPoint& grad = points_[i];
+
+				end.ddx = spline.ddx1();
+				end.ddy = spline.ddy1();
+				start.ddx = splinenext.ddx0();
+				start.ddy = splinenext.ddy0();
+
+				//
+				// Only the two splines that meet at this waypoint depend on its second derivative.
+				// They are probed as copies on the stack, which leaves the path as it was.
+				//
+				double original = costs_[i] + costs_[i + 1];
+				SplinePair probe = spline;
+				SplinePair probenext = splinenext;
+
+				probe.ddxy1(end.ddx + kEpsilon, end.ddy);
+				probenext.ddxy0(start.ddx + kEpsilon, start.ddy);
+				grad.ddx = (probe.sumDCurvature2() + probenext.sumDCurvature2() - original) / kEpsilon;
+
+				probe.ddxy1(end.ddx, end.ddy + kEpsilon);
+				probenext.ddxy0(start.ddx, start.ddy + kEpsilon);
+				grad.ddy = (probe.sumDCurvature2() + probenext.sumDCurvature2() - original) / kEpsilon;
+
+				grad.active = true;
+				magnitude += grad.ddx * grad.ddx + grad.ddy * grad.ddy;
+			}
+
+			return std::sqrt(magnitude);
+		}
+
+		double SplineOptimizer::moveControlPoints(std::vector<SplinePair>& splines, double step)
+		{
+			for (size_t i = 0; i < points_.size(); i++)
+			{
+				const ControlPoint& dir = points_[i];
+				if (!dir.active)
+					continue;
+
+				splines[i].ddxy1(end_[i].ddx + step * dir.ddx, end_[i].ddy + step * dir.ddy);
+				splines[i + 1].ddxy0(start_[i].ddx + step * dir.ddx, start_[i].ddy + step * dir.ddy);
+			}
+
+			return evalCost(splines);
+		}
+
+		bool SplineOptimizer::runIteration(std::vector<SplinePair>& splines, double& cost)
+		{
+			double magnitude = computeGradient(splines);
+			if (magnitude == 0.0 || !std::isfinite(magnitude))
+				return false;
+
+			//
+			// Turn the gradient into a unit length descent direction.  The slope of the cost
+			// along this direction is then the negative of the gradient magnitude.
+			//
+			for (ControlPoint& pt : points_)
+			{
+				pt.ddx /= -magnitude;
+				pt.ddy /= -magnitude;
+			}
+
+			double start = cost;
+			double slope = -magnitude;
+			double trial = moveControlPoints(splines, kStepSize);
+
+			//
+			// Fit a parabola to the cost at zero, the slope at zero, and the cost at one step
+			// and go to its minimum.  If the cost is not convex along the direction, use the step.
+			//
+			double step = kStepSize;
+			double evaluated = kStepSize;
+			double curve = trial - start - slope * kStepSize;
+			if (curve > 0.0)
+				step = -slope * kStepSize * kStepSize / (2.0 * curve);
+
+			for (int i = 0; i < kMaxBacktrack; i++)
+			{
+				if (step != evaluated)
+				{
+					trial = moveControlPoints(splines, step);
+					evaluated = step;
+				}
+
+				if (trial <= start + kArmijo * step * slope)
+				{
+					cost = trial;
+					return true;
+				}
+
+				step /= 2.0;
+			}
+
+			//
+			// No step along the gradient lowers the cost, put the splines back
+			//
+			cost = moveControlPoints(splines, 0.0);
+			return false;
+		}
+	}
+}
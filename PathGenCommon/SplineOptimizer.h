@@ -0,0 +1,86 @@
+#pragma once
+
+#include "SplinePair.h"
+#include <vector>
+
+namespace xero
+{
+	namespace paths
+	{
+		/// \brief adjusts the second derivatives at the interior waypoints of a path to minimize the
+		/// sum of the squared change in curvature along the path.
+		/// The cost of a path is the sum of the costs of its splines, and the second derivative at a
+		/// waypoint only changes the two splines that meet at that waypoint.  The gradient is therefore
+		/// computed by re-evaluating just those two splines for each waypoint, so an iteration is linear
+		/// in the number of waypoints.  The step along the gradient is chosen with a line search that fits
+		/// a parabola to the cost and backtracks until the cost decreases.
+		///
+		/// The working storage is kept in the optimizer and reused, so an optimizer that is kept
+		/// and used for path after path does not allocate once it has seen the largest path.
+		class SplineOptimizer
+		{
+		public:
+			SplineOptimizer();
+			virtual ~SplineOptimizer();
+
+			/// \brief optimize the splines in place
+			/// \param splines the splines for the path, spline i ends where spline i + 1 starts
+			/// \returns the final cost of the path
+			double optimize(std::vector<SplinePair>& splines);
+
+			/// \brief the number of iterations run by the last call to optimize()
+			int iterations() const {
+				return iterations_;
+			}
+
+			void setMaxIterations(int v) {
+				max_iterations_ = v;
+			}
+
+			void setMinDelta(double v) {
+				min_delta_ = v;
+			}
+
+			/// \brief the number of splines in the largest path that can be optimized without allocating
+			size_t capacity() const;
+
+		private:
+			struct ControlPoint {
+				ControlPoint() {
+					active = false;
+					ddx = 0;
+					ddy = 0;
+				}
+				bool active;
+				double ddx, ddy;
+			};
+
+			bool runIteration(std::vector<SplinePair>& splines, double &cost);
+			double computeGradient(std::vector<SplinePair>& splines);
+			double moveControlPoints(std::vector<SplinePair>& splines, double step);
+			double evalCost(std::vector<SplinePair>& splines);
+
+		private:
+			static constexpr int kMaxIterations = 100;
+			static constexpr double kMinDelta = 0.001;
+			static constexpr double kEpsilon = 1e-5;
+			static constexpr double kStepSize = 1.0;
+			static constexpr double kArmijo = 1e-4;
+			static constexpr int kMaxBacktrack = 10;
+
+		private:
+			int max_iterations_;
+			double min_delta_;
+			int iterations_;
+
+			// The cost of each spline, kept up to date with the splines
+			std::vector<double> costs_;
+
+			// The descent direction for each interior waypoint, and the second derivatives at the end
+			// of the spline before the waypoint and the start of the spline after it before the line search
+			std::vector<ControlPoint> points_;
+			std::vector<ControlPoint> end_;
+			std::vector<ControlPoint> start_;
+		};
+	}
+}
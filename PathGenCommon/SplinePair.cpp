@@ -15,88 +15,178 @@ namespace xero
 		}
 #endif
 
-		SplinePair::SplinePair(Pose2d p0, Pose2d p1)
-		{
-			double dist = p0.distance(p1);
-			double scale = 1.2 * dist;
-			double x0 = p0.getTranslation().getX();
-			double x1 = p1.getTranslation().getX();
-			double dx0 = p0.getRotation().getCos() * scale;
-			double dx1 = p1.getRotation().getCos() * scale;
-			double ddx0 = 0.0;
-			double ddx1 = 0.0;
-			x_ = new QuinticHermiteSpline(x0, x1, dx0, dx1, ddx0, ddx1);
-
-			double y0 = p0.getTranslation().getY();
-			double y1 = p1.getTranslation().getY();
-			double dy0 = p0.getRotation().getSin() * scale;
-			double dy1 = p1.getRotation().getSin() * scale;
-			double ddy0 = 0.0;
-			double ddy1 = 0.0;
-			y_ = new QuinticHermiteSpline(y0, y1, dy0, dy1, ddy0, ddy1);
+		//
+		// The first derivatives at the ends are the headings scaled by the distance between them
+		//
+		static double derivativeScale(const Pose2d& p0, const Pose2d& p1)
+		{
+			return 1.2 * p0.distance(p1);
+		}
 
+		SplinePair::SplinePair(Pose2d p0, Pose2d p1) :
+			x_(p0.getTranslation().getX(), p1.getTranslation().getX(),
+				p0.getRotation().getCos() * derivativeScale(p0, p1), p1.getRotation().getCos() * derivativeScale(p0, p1), 0.0, 0.0),
+			y_(p0.getTranslation().getY(), p1.getTranslation().getY(),
+				p0.getRotation().getSin() * derivativeScale(p0, p1), p1.getRotation().getSin() * derivativeScale(p0, p1), 0.0, 0.0)
+		{
 			has_step_ = false;
 			step_ = 0.1;
 		}
 
-		SplinePair::SplinePair(const QuinticHermiteSpline& x, const QuinticHermiteSpline& y)
+		SplinePair::SplinePair(const QuinticHermiteSpline& x, const QuinticHermiteSpline& y) : x_(x), y_(y)
 		{
-			x_ = new QuinticHermiteSpline(x);
-			y_ = new QuinticHermiteSpline(y);
-
 			has_step_ = false;
 			step_ = 0.1;
 		}
 
-		SplinePair::~SplinePair()
+		Translation2d SplinePair::evalPosition(double t) const
 		{
-			delete x_;
-			delete y_;
+			double xval = x_.eval(t);
+			double yval = y_.eval(t);
+
+			return Translation2d(xval, yval);
 		}
 
-		Translation2d SplinePair::evalPosition(double t)
+		Rotation2d SplinePair::evalHeading(double t) const
 		{
-			double xval = x_->eval(t);
-			double yval = y_->eval(t);
+			double xval = x_.derivative(t);
+			double yval = y_.derivative(t);
 
-			return Translation2d(xval, yval);
+			return Rotation2d(xval, yval, true);
 		}
 
-		Rotation2d SplinePair::evalHeading(double t)
+		SplineSample SplinePair::evalAll(double t) const
 		{
-			double xval = x_->derivative(t);
-			double yval = y_->derivative(t);
+			SplineSample s;
+			evalAll(&t, &s, 1);
+			return s;
+		}
 
-			return Rotation2d(xval, yval, true);
+		void SplinePair::evalAll(const double* t, SplineSample* out, size_t count) const
+		{
+			//
+			// The coefficients of the polynomial and its derivatives, x then y
+			//
+			const double a[2] = { x_.a(), y_.a() };
+			const double b[2] = { x_.b(), y_.b() };
+			const double c[2] = { x_.c(), y_.c() };
+			const double d[2] = { x_.d(), y_.d() };
+			const double e[2] = { x_.e(), y_.e() };
+			const double f[2] = { x_.f(), y_.f() };
+
+			const double a5[2] = { 5 * a[0], 5 * a[1] };
+			const double b4[2] = { 4 * b[0], 4 * b[1] };
+			const double c3[2] = { 3 * c[0], 3 * c[1] };
+			const double d2[2] = { 2 * d[0], 2 * d[1] };
+			const double a20[2] = { 20 * a[0], 20 * a[1] };
+			const double b12[2] = { 12 * b[0], 12 * b[1] };
+			const double c6[2] = { 6 * c[0], 6 * c[1] };
+			const double a60[2] = { 60 * a[0], 60 * a[1] };
+			const double b24[2] = { 24 * b[0], 24 * b[1] };
+
+			for (size_t i = 0; i < count; i++)
+			{
+				double tv = t[i];
+				SplineSample& s = out[i];
+
+				for (int k = 0; k < 2; k++)
+				{
+					s.v[k] = ((((a[k] * tv + b[k]) * tv + c[k]) * tv + d[k]) * tv + e[k]) * tv + f[k];
+					s.d1[k] = (((a5[k] * tv + b4[k]) * tv + c3[k]) * tv + d2[k]) * tv + e[k];
+					s.d2[k] = ((a20[k] * tv + b12[k]) * tv + c6[k]) * tv + d2[k];
+					s.d3[k] = (a60[k] * tv + b24[k]) * tv + c6[k];
+				}
+			}
 		}
 
-		double SplinePair::getCurvature(double t) 
+		double SplineSample::curvature() const
 		{
-			return (dx(t) * ddy(t) - ddx(t) * dy(t)) / ((dx(t) * dx(t) + dy(t) * dy(t)) * std::sqrt((dx(t) * dx(t) + dy(t) * dy(t))));
+			double dx2dy2 = d1[0] * d1[0] + d1[1] * d1[1];
+			return (d1[0] * d2[1] - d2[0] * d1[1]) / (dx2dy2 * std::sqrt(dx2dy2));
 		}
 
-		double SplinePair::getDCurvature(double t) 
+		double SplineSample::dcurvature() const
 		{
-			double dx2dy2 = (dx(t) * dx(t) + dy(t) * dy(t));
-			double num = (dx(t) * dddy(t) - dddx(t) * dy(t)) * dx2dy2 - 3 * (dx(t) * ddy(t) - ddx(t) * dy(t)) * (dx(t) * ddx(t) + dy(t) * ddy(t));
+			double dx2dy2 = d1[0] * d1[0] + d1[1] * d1[1];
+			double num = (d1[0] * d3[1] - d3[0] * d1[1]) * dx2dy2 - 3 * (d1[0] * d2[1] - d2[0] * d1[1]) * (d1[0] * d2[0] + d1[1] * d2[1]);
 			return num / (dx2dy2 * dx2dy2 * std::sqrt(dx2dy2));
 		}
 
-		double SplinePair::getDCurvature2(double t) 
+		double SplineSample::dcurvature2() const
 		{
-			double dx2dy2 = (dx(t) * dx(t) + dy(t) * dy(t));
-			double num = (dx(t) * dddy(t) - dddx(t) * dy(t)) * dx2dy2 - 3 * (dx(t) * ddy(t) - ddx(t) * dy(t)) * (dx(t) * ddx(t) + dy(t) * ddy(t));
+			double dx2dy2 = d1[0] * d1[0] + d1[1] * d1[1];
+			double num = (d1[0] * d3[1] - d3[0] * d1[1]) * dx2dy2 - 3 * (d1[0] * d2[1] - d2[0] * d1[1]) * (d1[0] * d2[0] + d1[1] * d2[1]);
 			return num * num / (dx2dy2 * dx2dy2 * dx2dy2 * dx2dy2 * dx2dy2);
 		}
 
-		Pose2d SplinePair::getStartPose()
+		double SplinePair::getCurvature(double t) const
+		{
+			return evalAll(t).curvature();
+		}
+
+		double SplinePair::getDCurvature(double t) const
+		{
+			return evalAll(t).dcurvature();
+		}
+
+		double SplinePair::getDCurvature2(double t) const
+		{
+			return evalAll(t).dcurvature2();
+		}
+
+		double SplinePair::sumDCurvature2() const
+		{
+			//
+			// Gauss-Legendre nodes and weights for five points on [-1, 1]
+			//
+			static const double nodes[kGaussPoints] =
+			{
+				-0.9061798459386639927976269,
+				-0.5384693101056830910363144,
+				0.0,
+				0.5384693101056830910363144,
+				0.9061798459386639927976269
+			};
+			static const double weights[kGaussPoints] =
+			{
+				0.2369268850561890875142640,
+				0.4786286704993664680412915,
+				0.5688888888888888888888889,
+				0.4786286704993664680412915,
+				0.2369268850561890875142640
+			};
+
+			double half = 0.5 / kGaussIntervals;
+			double t[kGaussIntervals * kGaussPoints];
+			SplineSample samples[kGaussIntervals * kGaussPoints];
+
+			for (int i = 0; i < kGaussIntervals; i++)
+			{
+				double mid = (2 * i + 1) * half;
+				for (int j = 0; j < kGaussPoints; j++)
+					t[i * kGaussPoints + j] = mid + half * nodes[j];
+			}
+
+			evalAll(t, samples, kGaussIntervals * kGaussPoints);
+
+			double sum = 0.0;
+			for (int i = 0; i < kGaussIntervals; i++)
+			{
+				for (int j = 0; j < kGaussPoints; j++)
+					sum += weights[j] * samples[i * kGaussPoints + j].dcurvature2();
+			}
+
+			return sum * half;
+		}
+
+		Pose2d SplinePair::getStartPose() const
 		{
-			return Pose2d(evalPosition(0), evalHeading(0));
+			return evalPose(0);
 		}
 
-		Pose2d SplinePair::getEndPose()
+		Pose2d SplinePair::getEndPose() const
 		{
-			return Pose2d(evalPosition(1), evalHeading(1));
+			return evalPose(1);
 		}
 	}
 }
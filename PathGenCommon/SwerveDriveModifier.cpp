@@ -26,7 +26,7 @@ namespace xero
 			if (main == nullptr)
 				return false;
 
-			double duration = (*main)[main->size() - 1].time();
+			double duration = main->times().back();
 			double rtime = duration - path->getStartAngleDelay() - path->getEndAngleDelay();
 			auto tp = createRotationProfile(robot, path);
 
@@ -46,10 +46,19 @@ namespace xero
 			Translation2d prevfl, prevfr, prevbl, prevbr;
 			double fldist = 0, frdist = 0, bldist = 0, brdist = 0;
 
+			const std::vector<double>& times = main->times();
+			const std::vector<double>& velocities = main->velocities();
+			const std::vector<double>& accelerations = main->accelerations();
+
+			flpts.reserve(main->size());
+			frpts.reserve(main->size());
+			blpts.reserve(main->size());
+			brpts.reserve(main->size());
+
 			for (size_t i = 0; i < main->size(); i++)
 			{
-				const Pose2dWithTrajectory& pt = (*main)[i];
-				double time = pt.time();
+				double time = times[i];
+				Translation2d where = main->translation(i);
 				Rotation2d angle = Rotation2d::fromDegrees(MathUtils::boundDegrees(path->getStartAngle() + tp->getDistance(time - path->getStartAngleDelay())));
 				double pangle = angle.toDegrees();
 				(void)pangle;
@@ -102,9 +111,9 @@ namespace xero
 				if (rotbracc.normalize() > robot.getMaxAccel())
 					return false;
 
-				Rotation2d heading = pt.rotation();
-				Translation2d pathvel = Translation2d(heading, pt.velocity()).rotateBy(Rotation2d::fromDegrees(-angle.toDegrees()));
-				Translation2d pathacc = Translation2d(heading, pt.acceleration()).rotateBy(Rotation2d::fromDegrees(-angle.toDegrees()));
+				Rotation2d heading = main->rotation(i);
+				Translation2d pathvel = Translation2d(heading, velocities[i]).rotateBy(Rotation2d::fromDegrees(-angle.toDegrees()));
+				Translation2d pathacc = Translation2d(heading, accelerations[i]).rotateBy(Rotation2d::fromDegrees(-angle.toDegrees()));
 
 				Translation2d flv = rotflvel + pathvel;
 				Translation2d frv = rotfrvel + pathvel;
@@ -116,10 +125,10 @@ namespace xero
 				Translation2d bla = rotblacc + pathacc;
 				Translation2d bra = rotbracc + pathacc;
 
-				Translation2d flpos = Translation2d(robot.getEffectiveLength() / 2.0, robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(pt.translation());
-				Translation2d frpos = Translation2d(robot.getEffectiveLength() / 2.0, -robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(pt.translation());
-				Translation2d blpos = Translation2d(-robot.getEffectiveLength() / 2.0, robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(pt.translation());
-				Translation2d brpos = Translation2d(-robot.getEffectiveLength() / 2.0, -robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(pt.translation());
+				Translation2d flpos = Translation2d(robot.getEffectiveLength() / 2.0, robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(where);
+				Translation2d frpos = Translation2d(robot.getEffectiveLength() / 2.0, -robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(where);
+				Translation2d blpos = Translation2d(-robot.getEffectiveLength() / 2.0, robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(where);
+				Translation2d brpos = Translation2d(-robot.getEffectiveLength() / 2.0, -robot.getEffectiveWidth() / 2.0).rotateBy(angle).translateBy(where);
 
 				if (!first)
 				{
@@ -154,7 +163,7 @@ namespace xero
 				prevbl = blpos;
 				prevbr = brpos;
 
-				(*main)[i].setSwRotation(angle.toDegrees());
+				main->setSwRotation(i, angle.toDegrees());
 			}
 
 			std::shared_ptr<PathTrajectory> fl = std::make_shared<PathTrajectory>(TrajectoryName::FL, flpts);
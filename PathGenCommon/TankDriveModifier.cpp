@@ -1,6 +1,6 @@
 #include "TankDriveModifier.h"
 #include "TrajectoryNames.h"
-#include "Pose2DWithCurvature.h"
+#include <algorithm>
 #include <cmath>
 
 namespace xero
@@ -26,100 +26,153 @@ namespace xero
 			//
 			double width = UnitConverter::convert(robot.getEffectiveWidth(), robot.getLengthUnits(), units);
 
-			std::vector<Pose2dWithTrajectory> leftpts;
-			std::vector<Pose2dWithTrajectory> rightpts;
+			//
+			// The sides share the times and headings of the center, so start with copies of it
+			// and replace the columns that differ in place
+			//
+			std::shared_ptr<PathTrajectory> left = std::make_shared<PathTrajectory>(TrajectoryName::Left, *main);
+			std::shared_ptr<PathTrajectory> right = std::make_shared<PathTrajectory>(TrajectoryName::Right, *main);
+
+			SideColumns lcols = sideColumns(*left);
+			SideColumns rcols = sideColumns(*right);
+
+			computeSides(main->size(), width, main->times().data(), main->xs().data(), main->ys().data(),
+				main->headingCos().data(), main->headingSin().data(), lcols, rcols);
+
+			double* lrot = left->columnData(TrajectoryColumn::Rotation);
+			double* rrot = right->columnData(TrajectoryColumn::Rotation);
+			std::fill(lrot, lrot + left->size(), 0.0);
+			std::fill(rrot, rrot + right->size(), 0.0);
+
+			path->addTrajectory(left);
+			path->addTrajectory(right);
+
+			return true;
+		}
+
+		TankDriveModifier::SideColumns TankDriveModifier::sideColumns(PathTrajectory& traj)
+		{
+			SideColumns cols;
+
+			cols.x = traj.columnData(TrajectoryColumn::X);
+			cols.y = traj.columnData(TrajectoryColumn::Y);
+			cols.position = traj.columnData(TrajectoryColumn::Position);
+			cols.velocity = traj.columnData(TrajectoryColumn::Velocity);
+			cols.acceleration = traj.columnData(TrajectoryColumn::Acceleration);
+			cols.jerk = traj.columnData(TrajectoryColumn::Jerk);
+			cols.curvature = traj.columnData(TrajectoryColumn::Curvature);
+
+			return cols;
+		}
 
-			double lcurv = 0, rcurv = 0;
-			double lvel = 0, lacc = 0, lpos = 0, ljerk = 0;
-			double rvel = 0, racc = 0, rpos = 0, rjerk = 0;
-			double plx = 0, ply = 0, prx = 0, pry = 0;
-			double plvel = 0, prvel = 0;
-			double placc = 0, pracc = 0;
+		//
+		// The curvature through three points, computed as Pose2dWithCurvature::curvature does
+		// but with the straight line distances between the points in place of the distances
+		// between the poses
+		//
+		static inline double curvature(double ax, double ay, double bx, double by, double cx, double cy)
+		{
+			double area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+			double d1 = (bx - ax) * (bx - ax) + (by - ay) * (by - ay);
+			double d2 = (cx - bx) * (cx - bx) + (cy - by) * (cy - by);
+			double d3 = (cx - ax) * (cx - ax) + (cy - ay) * (cy - ay);
 
-			for (size_t i = 0; i < main->size(); i++)
+			return 4.0 * area / std::sqrt(d1 * d2 * d3);
+		}
+
+		//
+		// One side of the robot, offset from the center by the signed distance given, positive to
+		// the left.  The columns are not allowed to overlap, which leaves the loops free of any
+		// alias checks.
+		//
+		static void computeSide(size_t n, double offset, const double* __restrict time, const double* __restrict x,
+			const double* __restrict y, const double* __restrict cosv, const double* __restrict sinv,
+			double* __restrict sx, double* __restrict sy, double* __restrict pos, double* __restrict vel,
+			double* __restrict acc, double* __restrict jerk, double* __restrict curv)
+		{
+			//
+			// The first and last points have no neighbor on one side, the robot starts from rest
+			// and the curvature at either end is zero
+			//
+			sx[0] = x[0] - offset * sinv[0];
+			sy[0] = y[0] + offset * cosv[0];
+			pos[0] = 0.0;
+			vel[0] = 0.0;
+			acc[0] = 0.0;
+			jerk[0] = 0.0;
+			curv[0] = 0.0;
+
+			if (n == 1)
+				return;
+
+			//
+			// Each point depends only on the center columns and not on the results for the point
+			// before it, so this loop has no branches and no dependence between iterations and the
+			// compiler can vectorize it.  The side points next to a point are computed again rather
+			// than read back.  The distance from the previous point is left in the position column
+			// to be summed below.
+			//
+			for (size_t i = 1; i < n - 1; i++)
 			{
-				const Pose2dWithTrajectory& pt = (*main)[i];
-				double time = pt.time();
-				double px = pt.x();
-				double py = pt.y();
-
-				double lx = px - width * pt.rotation().getSin() / 2.0;
-				double ly = py + width * pt.rotation().getCos() / 2.0;
-				double rx = px + width * pt.rotation().getSin() / 2.0;
-				double ry = py - width * pt.rotation().getCos() / 2.0;
-
-				if (i == 0)
-				{
-					lvel = 0.0;
-					lacc = 0.0;
-					lpos = 0.0;
-					ljerk = 0.0;
-
-					rvel = 0.0;
-					racc = 0.0;
-					rpos = 0.0;
-					rjerk = 0.0;
-				}
-				else
-				{
-					double dt = time - (*main)[i - 1].time();
-					double ldist = std::sqrt((lx - plx) * (lx - plx) + (ly - ply) * (ly - ply));
-					double rdist = std::sqrt((rx - prx) * (rx - prx) + (ry - pry) * (ry - pry));
-
-					lvel = ldist / dt;
-					rvel = rdist / dt;
-
-					lacc = (lvel - plvel) / dt;
-					racc = (rvel - prvel) / dt;
-
-					ljerk = (lacc - placc) / dt;
-					rjerk = (racc - pracc) / dt;
-
-					lpos += ldist;
-					rpos += rdist;
-				}
-
-				Translation2d lpt(lx, ly);
-				Pose2d l2d(lpt, pt.rotation());
-				Pose2dWithTrajectory ltraj(l2d, time, lpos, lvel, lacc, ljerk, lcurv, 0.0);
-				leftpts.push_back(ltraj);
-
-				Translation2d rpt(rx, ry);
-				Pose2d r2d(rpt, pt.rotation());
-				Pose2dWithTrajectory rtraj(r2d, time, rpos, rvel, racc, rjerk, rcurv, 0.0);
-				rightpts.push_back(rtraj);
-
-				plx = lx;
-				ply = ly;
-				prx = rx;
-				pry = ry;
-				plvel = lvel;
-				prvel = rvel;
-				placc = lacc;
-				pracc = racc;
+				double x0 = x[i - 1] - offset * sinv[i - 1];
+				double y0 = y[i - 1] + offset * cosv[i - 1];
+				double x1 = x[i] - offset * sinv[i];
+				double y1 = y[i] + offset * cosv[i];
+				double x2 = x[i + 1] - offset * sinv[i + 1];
+				double y2 = y[i + 1] + offset * cosv[i + 1];
+
+				double dist = std::sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+
+				sx[i] = x1;
+				sy[i] = y1;
+				pos[i] = dist;
+				vel[i] = dist / (time[i] - time[i - 1]);
+				curv[i] = curvature(x0, y0, x1, y1, x2, y2);
 			}
 
-			assert(leftpts.size() == rightpts.size());
-			for (int i = 0; i < leftpts.size(); i++) {
-				if (i == 0 || i == leftpts.size() - 1)
-				{
-					lcurv = 0.0;
-					rcurv = 0.0;
-				}
-				else
-				{
-					leftpts[i].setCurvature(xero::paths::Pose2dWithCurvature::curvature(leftpts[i - 1].pose(), leftpts[i].pose(), leftpts[i + 1].pose()));
-					rightpts[i].setCurvature(xero::paths::Pose2dWithCurvature::curvature(rightpts[i - 1].pose(), rightpts[i].pose(), rightpts[i + 1].pose()));
-				}
+			size_t last = n - 1;
+			sx[last] = x[last] - offset * sinv[last];
+			sy[last] = y[last] + offset * cosv[last];
+			pos[last] = std::sqrt((sx[last] - sx[last - 1]) * (sx[last] - sx[last - 1]) + (sy[last] - sy[last - 1]) * (sy[last] - sy[last - 1]));
+			vel[last] = pos[last] / (time[last] - time[last - 1]);
+			curv[last] = 0.0;
+
+			//
+			// The acceleration and jerk are differences of the velocities.  The acceleration at the
+			// previous point is found again from the velocities so this loop can be vectorized as well.
+			//
+			double dt = time[1] - time[0];
+			acc[1] = vel[1] / dt;
+			jerk[1] = acc[1] / dt;
+
+			for (size_t i = 2; i < n; i++)
+			{
+				double dt0 = time[i - 1] - time[i - 2];
+				double dt1 = time[i] - time[i - 1];
+				double acc0 = (vel[i - 1] - vel[i - 2]) / dt0;
+				double acc1 = (vel[i] - vel[i - 1]) / dt1;
+
+				acc[i] = acc1;
+				jerk[i] = (acc1 - acc0) / dt1;
 			}
 
-			std::shared_ptr<PathTrajectory> left = std::make_shared<PathTrajectory>(TrajectoryName::Left, leftpts);
-			std::shared_ptr<PathTrajectory> right = std::make_shared<PathTrajectory>(TrajectoryName::Right, rightpts);
+			//
+			// The position is the running sum of the distances
+			//
+			for (size_t i = 1; i < n; i++)
+				pos[i] += pos[i - 1];
+		}
 
-			path->addTrajectory(left);
-			path->addTrajectory(right);
+		void TankDriveModifier::computeSides(size_t n, double width, const double* time, const double* x, const double* y,
+			const double* cosv, const double* sinv, const SideColumns& left, const SideColumns& right)
+		{
+			if (n == 0)
+				return;
 
-			return true;
+			computeSide(n, width / 2.0, time, x, y, cosv, sinv, left.x, left.y, left.position, left.velocity,
+				left.acceleration, left.jerk, left.curvature);
+			computeSide(n, -width / 2.0, time, x, y, cosv, sinv, right.x, right.y, right.position, right.velocity,
+				right.acceleration, right.jerk, right.curvature);
 		}
 	}
 }
\ No newline at end of file
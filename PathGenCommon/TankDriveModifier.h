@@ -9,11 +9,37 @@ namespace xero
 
 		class TankDriveModifier : public DriveModifier
 		{
+		public:
+			//
+			// The columns computed for one side of the robot, each with one entry per point
+			//
+			struct SideColumns
+			{
+				double* x;
+				double* y;
+				double* position;
+				double* velocity;
+				double* acceleration;
+				double* jerk;
+				double* curvature;
+			};
+
 		public:
 			TankDriveModifier();
 			virtual ~TankDriveModifier();
 
 			virtual bool modify(const RobotParams& robot, std::shared_ptr<RobotPath> path, const std::string& units);
+
+			//
+			// Computes the left and right side columns for the n points of a center trajectory
+			// given by its times, positions and the cosine and sine of its headings.  The side
+			// columns must not overlap the center columns or each other.
+			//
+			static void computeSides(size_t n, double width, const double* time, const double* x, const double* y,
+				const double* cosv, const double* sinv, const SideColumns& left, const SideColumns& right);
+
+		private:
+			static SideColumns sideColumns(PathTrajectory& traj);
 		};
 	}
 }
@@ -1,36 +1,123 @@
 #include "TrajectoryUtils.h"
+#include <algorithm>
+#include <thread>
+#include <cmath>
 
 namespace xero
 {
 	namespace paths
 	{
-		std::vector<Pose2d> TrajectoryUtils::parameterize(const std::vector<std::shared_ptr<xero::paths::SplinePair>>& splines,
-															double maxDx, double maxDy, double maxDTheta)
+		std::vector<Pose2d> TrajectoryUtils::parameterize(const std::vector<SplinePair>& splines,
+															double maxDx, double maxDy, double maxDTheta, bool parallel)
 		{
 			std::vector<Pose2d> results;
+			size_t count = splines.size();
+			size_t nthreads = 1;
 
-			results.push_back(splines[0]->getStartPose());
-			for (size_t i = 0; i < splines.size(); i++)
-				getSegmentArc(splines[i], results, 0.0, 1.0, maxDx, maxDy, maxDTheta);
+			if (parallel)
+				nthreads = std::min(count, static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())));
+
+			if (nthreads <= 1)
+			{
+				results.reserve(estimatePoses(splines, 0, count, maxDx, maxDTheta));
+				results.push_back(splines[0].getStartPose());
+				parameterizeRange(splines, 0, count, results, maxDx, maxDy, maxDTheta);
+				return results;
+			}
+
+			//
+			// Each thread gets a contiguous run of splines so the results can just be joined
+			//
+			std::vector<std::vector<Pose2d>> parts(nthreads);
+			std::vector<std::thread> threads;
+			for (size_t i = 0; i < nthreads; i++)
+			{
+				size_t first = count * i / nthreads;
+				size_t last = count * (i + 1) / nthreads;
+				threads.push_back(std::thread([&splines, &parts, i, first, last, maxDx, maxDy, maxDTheta]() {
+					parts[i].reserve(estimatePoses(splines, first, last, maxDx, maxDTheta));
+					parameterizeRange(splines, first, last, parts[i], maxDx, maxDy, maxDTheta);
+				}));
+			}
+
+			size_t total = 1;
+			for (size_t i = 0; i < nthreads; i++)
+			{
+				threads[i].join();
+				total += parts[i].size();
+			}
+
+			results.reserve(total);
+			results.push_back(splines[0].getStartPose());
+			for (const std::vector<Pose2d>& part : parts)
+				results.insert(results.end(), part.begin(), part.end());
 
 			return results;
 		}
 
-		void TrajectoryUtils::getSegmentArc(std::shared_ptr<SplinePair> pair, std::vector<Pose2d>& results, 
-											double t0, double t1, double maxDx, double maxDy, double maxDTheta)
+		void TrajectoryUtils::parameterizeRange(const std::vector<SplinePair>& splines, size_t first, size_t last,
+												std::vector<Pose2d>& results, double maxDx, double maxDy, double maxDTheta)
+		{
+			std::vector<ArcPoint> stack;
+			stack.reserve(64);
+
+			for (size_t i = first; i < last; i++)
+				getSegmentArc(splines[i], results, stack, maxDx, maxDy, maxDTheta);
+		}
+
+		//
+		// A guess at the number of poses, based on the chord and the change in heading of
+		// each spline.  This is only used to size the results, so it does not need to be exact.
+		//
+		size_t TrajectoryUtils::estimatePoses(const std::vector<SplinePair>& splines, size_t first, size_t last,
+											  double maxDx, double maxDTheta)
 		{
-			const Translation2d& p0 = pair->evalPosition(t0);
-			const Translation2d& p1 = pair->evalPosition(t1);
-			const Rotation2d& r0 = pair->evalHeading(t0);
-			const Rotation2d& r1 = pair->evalHeading(t1);
-			Pose2d transformation = Pose2d(Translation2d(p0, p1).rotateBy(r0.inverse()), r1.rotateBy(r0.inverse()));
-			Twist2d twist = Pose2d::logfn(transformation);
-			if (twist.getY() > maxDy || twist.getX() > maxDx || twist.getTheta() > maxDTheta) {
-				getSegmentArc(pair, results, t0, (t0 + t1) / 2, maxDx, maxDy, maxDTheta);
-				getSegmentArc(pair, results, (t0 + t1) / 2, t1, maxDx, maxDy, maxDTheta);
+			double est = 1.0;
+			for (size_t i = first; i < last; i++)
+			{
+				Pose2d start = splines[i].getStartPose();
+				Pose2d end = splines[i].getEndPose();
+				double dist = start.getTranslation().distance(end.getTranslation());
+				double dtheta = std::fabs(end.getRotation().rotateBy(start.getRotation().inverse()).toRadians());
+				est += 1.0 + dist / maxDx + dtheta / maxDTheta;
 			}
-			else {
-				results.push_back(pair->evalPose(t1));
+
+			return static_cast<size_t>(est);
+		}
+
+		//
+		// Bisect the spline until the twist between neighboring points is small enough.  This
+		// visits the intervals in the same order as a depth first recursion would, but keeps the
+		// pending right hand endpoints on an explicit stack so each point on the spline is
+		// evaluated only once and is shared by the two intervals on either side of it.
+		//
+		void TrajectoryUtils::getSegmentArc(const SplinePair& pair, std::vector<Pose2d>& results, std::vector<ArcPoint>& stack,
+											double maxDx, double maxDy, double maxDTheta)
+		{
+			SplineSample s = pair.evalAll(0.0);
+			ArcPoint left = { 0.0, s.position(), s.heading() };
+
+			s = pair.evalAll(1.0);
+			stack.clear();
+			stack.push_back({ 1.0, s.position(), s.heading() });
+
+			while (!stack.empty())
+			{
+				const ArcPoint& right = stack.back();
+
+				Rotation2d inv = left.heading_.inverse();
+				Pose2d transformation = Pose2d(Translation2d(left.pos_, right.pos_).rotateBy(inv), right.heading_.rotateBy(inv));
+				Twist2d twist = Pose2d::logfn(transformation);
+				if (twist.getY() > maxDy || twist.getX() > maxDx || twist.getTheta() > maxDTheta) {
+					double t = (left.t_ + right.t_) / 2;
+					s = pair.evalAll(t);
+					stack.push_back({ t, s.position(), s.heading() });
+				}
+				else {
+					results.push_back(Pose2d(right.pos_, right.heading_));
+					left = right;
+					stack.pop_back();
+				}
 			}
 		}
 	}
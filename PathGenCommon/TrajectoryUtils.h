@@ -14,13 +14,31 @@ namespace xero
 			TrajectoryUtils() = delete;
 			~TrajectoryUtils() = delete;
 
-			static std::vector<Pose2d> parameterize(const std::vector<std::shared_ptr<SplinePair>>& splines,
-													double maxDx, double maxDy, double maxDTheta);
+			//
+			// Break the splines into poses close enough together that the twist between any
+			// two neighboring poses is within maxDx, maxDy, and maxDTheta.  If parallel is true,
+			// the splines are divided across threads and the results joined in spline order,
+			// which gives the same poses as the single threaded version.
+			//
+			static std::vector<Pose2d> parameterize(const std::vector<SplinePair>& splines,
+													double maxDx, double maxDy, double maxDTheta, bool parallel = false);
 
 		private:
-			static void getSegmentArc(std::shared_ptr<SplinePair> pair, std::vector<Pose2d>& results,
-									  double t0, double t1, double maxDx, double maxDy, double maxDTheta);
+			struct ArcPoint
+			{
+				double t_;
+				Translation2d pos_;
+				Rotation2d heading_;
+			};
+
+			static void parameterizeRange(const std::vector<SplinePair>& splines, size_t first, size_t last,
+										  std::vector<Pose2d>& results, double maxDx, double maxDy, double maxDTheta);
+
+			static size_t estimatePoses(const std::vector<SplinePair>& splines, size_t first, size_t last,
+										double maxDx, double maxDTheta);
+
+			static void getSegmentArc(const SplinePair& pair, std::vector<Pose2d>& results, std::vector<ArcPoint>& stack,
+									  double maxDx, double maxDy, double maxDTheta);
 		};
 	}
 }
-
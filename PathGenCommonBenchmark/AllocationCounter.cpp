@@ -0,0 +1,163 @@
+#include "Benchmarks.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//
+// Replacements for all of the global allocation functions, so that every allocation the
+// program makes is counted and each form of operator delete frees memory the way the
+// matching operator new got it.  These are only linked into the benchmark program.
+//
+static std::atomic<size_t> allocations(0);
+
+size_t allocationCount()
+{
+	return allocations;
+}
+
+static void* allocate(std::size_t size)
+{
+	allocations++;
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+static void* allocateAligned(std::size_t size, std::align_val_t align)
+{
+	size_t a = static_cast<size_t>(align);
+
+	allocations++;
+	size = (size + a - 1) / a * a;
+	if (size == 0)
+		size = a;
+
+#ifdef _WIN32
+	return _aligned_malloc(size, a);
+#else
+	return std::aligned_alloc(a, size);
+#endif
+}
+
+static void freeAligned(void* p)
+{
+#ifdef _WIN32
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size)
+{
+	void* p = allocate(size);
+	if (p == nullptr)
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new[](std::size_t size)
+{
+	void* p = allocate(size);
+	if (p == nullptr)
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+	void* p = allocateAligned(size, align);
+	if (p == nullptr)
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+	void* p = allocateAligned(size, align);
+	if (p == nullptr)
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+	return allocateAligned(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+	return allocateAligned(size, align);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	freeAligned(p);
+}
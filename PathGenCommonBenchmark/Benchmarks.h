@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+//
+// The number of heap allocations made by the benchmark program so far.  Every form of the
+// global operator new in this program is replaced to count them, see AllocationCounter.cpp.
+//
+size_t allocationCount();
+
+//
+// Each benchmark prints its results, the times depend on the machine so nothing is checked
+//
+void splineAllocationBenchmark();
+void dcurvature2Benchmark();
+void csvReaderBenchmark();
+void jsonDocumentBenchmark();
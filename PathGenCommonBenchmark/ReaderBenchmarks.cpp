@@ -0,0 +1,128 @@
+#include "Benchmarks.h"
+#include <TestPaths.h>
+#include <CSVTrajectoryReader.h>
+#include <JSONDocument.h>
+#include <JSON.h>
+#include <JSONValue.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+using namespace xero::paths;
+using namespace xero::paths::test;
+
+//
+// Reading a 10,000 point trajectory, compared to parsing a line at a time
+//
+void csvReaderBenchmark()
+{
+	const int loops = 5;
+	std::string text = writeTrajectory(makeTrajectory(10000), { "time", "x", "y", "position", "velocity", "acceleration", "jerk", "heading", "curvature" });
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loops; i++)
+	{
+		PathTrajectory traj("main");
+		readByLine(text, traj);
+	}
+	auto mid = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loops; i++)
+	{
+		PathTrajectory traj("main");
+		CSVTrajectoryReader::parse(text, traj);
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	double byline = std::chrono::duration<double, std::milli>(mid - start).count() / loops;
+	double reader = std::chrono::duration<double, std::milli>(end - mid).count() / loops;
+
+	std::cout << "CSV trajectory reader" << std::endl;
+	std::cout << "  10000 rows: line parser " << byline << " ms, trajectory reader " << reader << " ms" << std::endl;
+}
+
+static std::string makePathFile(int paths, int points)
+{
+	std::stringstream strm;
+
+	strm << "{\n  \"_version\": 1,\n  \"groups\": [\n    {\n      \"name\": \"group\",\n      \"paths\": [\n";
+	for (int p = 0; p < paths; p++)
+	{
+		strm << "        {\n          \"name\": \"path" << p << "\",\n";
+		strm << "          \"startvelocity\": 0, \"endvelocity\": 0, \"maxvelocity\": 120.5, \"maxacceleration\": 80.25, \"maxjerk\": 1000,\n";
+		strm << "          \"constraints\": [], \"flags\": [ { \"name\": \"flag\", \"before\": 10, \"after\": 20 } ],\n";
+		strm << "          \"points\": [\n";
+		for (int i = 0; i < points; i++)
+		{
+			strm << "            { \"x\": " << i * 12.345 << ", \"y\": " << i * -3.21 << ", \"heading\": " << (i % 360) * 1.5 << " }";
+			strm << (i + 1 < points ? ",\n" : "\n");
+		}
+		strm << "          ]\n        }" << (p + 1 < paths ? ",\n" : "\n");
+	}
+	strm << "      ]\n    }\n  ]\n}\n";
+
+	return strm.str();
+}
+
+//
+// Reading a large path file and summing the waypoints with JSON and JSONValue, compared to
+// JSONDocument
+//
+void jsonDocumentBenchmark()
+{
+	const int loops = 5;
+	std::string text = makePathFile(50, 200);
+	double sum1 = 0.0, sum2 = 0.0;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loops; i++)
+	{
+		std::wstring wide;
+		for (char ch : text)
+			wide += (wchar_t)ch;
+
+		JSONValue* value = JSON::Parse(wide.c_str());
+		if (value == nullptr)
+		{
+			std::cerr << "JSON could not parse the path file" << std::endl;
+			return;
+		}
+
+		JSONArray groups = value->AsObject().at(L"groups")->AsArray();
+		JSONArray paths = groups[0]->AsObject().at(L"paths")->AsArray();
+		for (JSONValue* path : paths)
+		{
+			JSONArray points = path->AsObject().at(L"points")->AsArray();
+			for (JSONValue* pt : points)
+				sum1 += pt->AsObject().at(L"x")->AsNumber();
+		}
+		delete value;
+	}
+	auto mid = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loops; i++)
+	{
+		JSONDocument doc;
+		if (!doc.parse(text))
+		{
+			std::cerr << "JSONDocument could not parse the path file - " << doc.error() << std::endl;
+			return;
+		}
+
+		JSONDocument::Value paths = doc.root()["groups"][0]["paths"];
+		for (size_t p = 0; p < paths.size(); p++)
+		{
+			JSONDocument::Value points = paths[p]["points"];
+			for (size_t j = 0; j < points.size(); j++)
+				sum2 += points[j]["x"].asNumber();
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	double simple = std::chrono::duration<double, std::milli>(mid - start).count() / loops;
+	double document = std::chrono::duration<double, std::milli>(end - mid).count() / loops;
+
+	std::cout << "JSON path file" << std::endl;
+	std::cout << "  " << text.size() << " bytes: JSON/JSONValue " << simple << " ms, JSONDocument " << document << " ms" << std::endl;
+	if (std::fabs(sum1 - sum2) > 1.0e-6 * std::fabs(sum1))
+		std::cerr << "  the two parsers read different values, " << sum1 << " and " << sum2 << std::endl;
+}
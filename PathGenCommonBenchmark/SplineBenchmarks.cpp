@@ -0,0 +1,96 @@
+#include "Benchmarks.h"
+#include <TestPaths.h>
+#include <SplineOptimizer.h>
+#include <RobotPath.h>
+#include <chrono>
+#include <iostream>
+
+using namespace xero::paths;
+using namespace xero::paths::test;
+
+//
+// A path with the given number of waypoints, weaving left and right
+//
+static std::vector<Pose2d> weavePoints(size_t count)
+{
+	std::vector<Pose2d> points;
+	for (size_t i = 0; i < count; i++)
+		points.push_back(Pose2d(Translation2d(i * 60.0, (i % 2) * 40.0), Rotation2d::fromDegrees((i % 2) ? -30.0 : 30.0)));
+
+	return points;
+}
+
+static void countAllocations(const std::string& name, const std::vector<Pose2d>& points)
+{
+	RobotPath path(nullptr, name);
+	for (const Pose2d& pt : points)
+		path.addPoint(pt);
+
+	size_t start = allocationCount();
+	path.generateSplines();
+	size_t generate = allocationCount() - start;
+
+	start = allocationCount();
+	path.generateSplines();
+	size_t regenerate = allocationCount() - start;
+
+	auto splines = makeSplines(points);
+	auto original = splines;
+	SplineOptimizer opt;
+
+	start = allocationCount();
+	opt.optimize(splines);
+	size_t first = allocationCount() - start;
+
+	splines = original;
+	start = allocationCount();
+	opt.optimize(splines);
+	size_t second = allocationCount() - start;
+
+	std::cout << "  " << name << ", " << points.size() << " points: generateSplines " << generate << " then " << regenerate
+		<< ", optimize " << first << " then " << second << " (" << opt.iterations() << " iterations)" << std::endl;
+}
+
+//
+// The heap allocations made creating and optimizing the splines for a path, the first time
+// and again.  The splines for a path are kept by value and the optimizer reuses its storage,
+// so the second time should not allocate at all.
+//
+void splineAllocationBenchmark()
+{
+	std::cout << "spline allocations" << std::endl;
+	countAllocations("sample", samplePoints());
+	countAllocations("weave", weavePoints(20));
+}
+
+//
+// Compares the cost of the quadrature for the change in curvature to the fixed step sum
+// it replaced
+//
+void dcurvature2Benchmark()
+{
+	const int loops = 2000;
+	std::vector<SplinePair> splines = makeSplines(samplePoints());
+
+	volatile double sink = 0.0;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loops; i++)
+	{
+		for (const SplinePair& pair : splines)
+			sink = sink + pair.sumDCurvature2Sampled();
+	}
+	auto mid = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loops; i++)
+	{
+		for (const SplinePair& pair : splines)
+			sink = sink + pair.sumDCurvature2();
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	double sampled = std::chrono::duration<double, std::micro>(mid - start).count() / (loops * splines.size());
+	double gauss = std::chrono::duration<double, std::micro>(end - mid).count() / (loops * splines.size());
+
+	std::cout << "sumDCurvature2" << std::endl;
+	std::cout << "  sampled " << sampled << " us, gauss-legendre " << gauss << " us per spline" << std::endl;
+}
@@ -0,0 +1,68 @@
+#include "Benchmarks.h"
+#include <iostream>
+#include <string>
+
+//
+// Runs the PathGenCommon benchmarks named on the command line, or all of them.  These are
+// kept out of the unit tests since they are slow and report numbers rather than check them.
+//
+struct Benchmark
+{
+	const char* name_;
+	void (*run_)();
+};
+
+static const Benchmark benchmarks[] =
+{
+	{ "splinealloc", splineAllocationBenchmark },
+	{ "dcurvature2", dcurvature2Benchmark },
+	{ "csvreader", csvReaderBenchmark },
+	{ "jsondocument", jsonDocumentBenchmark },
+};
+
+static void usage()
+{
+	std::cout << "usage: PathGenCommonBenchmark [name ...]" << std::endl;
+	std::cout << "benchmarks:";
+	for (const Benchmark& b : benchmarks)
+		std::cout << " " << b.name_;
+	std::cout << std::endl;
+}
+
+int main(int ac, char** av)
+{
+	ac--;
+	av++;
+
+	if (ac == 0)
+	{
+		for (const Benchmark& b : benchmarks)
+			b.run_();
+
+		return 0;
+	}
+
+	while (ac-- > 0)
+	{
+		std::string name = *av++;
+		bool found = false;
+
+		for (const Benchmark& b : benchmarks)
+		{
+			if (name == b.name_)
+			{
+				b.run_();
+				found = true;
+			}
+		}
+
+		if (!found)
+		{
+			std::cerr << "PathGenCommonBenchmark: unknown benchmark '" << name << "'" << std::endl;
+			usage();
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "TestPaths.h"
+#include <BinaryWriter.h>
+#include <BinaryTrajectoryFile.h>
+#include <BinaryTrajectoryReader.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static std::vector<std::string> allHeaders()
+			{
+				return { "time", "x", "y", "heading", "position", "velocity", "acceleration", "jerk", "curvature", "rotation" };
+			}
+
+			static std::string writeFile(const PathTrajectory& traj, std::vector<std::string> headers)
+			{
+				std::stringstream strm;
+				EXPECT_TRUE(BinaryWriter::write<PathTrajectory::const_iterator>(strm, headers, traj.begin(), traj.end()));
+				return strm.str();
+			}
+
+			TEST(BinaryTrajectory, Layout)
+			{
+				PathTrajectory traj = makeTrajectory(10);
+				std::string data = writeFile(traj, { "time", "x" });
+
+				ASSERT_EQ(32u + 2 * 32u + 2 * 10 * sizeof(double), data.size());
+				EXPECT_EQ(0, std::memcmp(data.data(), "XEROTRJ", 8));
+				EXPECT_EQ(1, data[8]);
+				EXPECT_EQ(2, data[12]);
+				EXPECT_EQ(10, data[16]);
+				EXPECT_EQ("time", std::string(data.data() + 32));
+				EXPECT_EQ(96, data[32 + 24]);
+				EXPECT_EQ("x", std::string(data.data() + 64));
+				EXPECT_EQ(96 + 80, static_cast<unsigned char>(data[64 + 24]));
+			}
+
+			TEST(BinaryTrajectory, AttachIsZeroCopy)
+			{
+				PathTrajectory traj = makeTrajectory(100);
+				std::string data = writeFile(traj, allHeaders());
+				std::vector<double> aligned((data.size() + sizeof(double) - 1) / sizeof(double));
+				std::memcpy(aligned.data(), data.data(), data.size());
+
+				BinaryTrajectoryFile file;
+				ASSERT_TRUE(file.attach(aligned.data(), data.size())) << file.error();
+				ASSERT_EQ(100u, file.rows());
+				ASSERT_EQ(10u, file.columnCount());
+				EXPECT_EQ("velocity", file.columnName(5));
+
+				const char* base = reinterpret_cast<const char*>(aligned.data());
+				const char* times = reinterpret_cast<const char*>(file.times());
+				EXPECT_TRUE(times >= base && times < base + data.size());
+
+				for (size_t i = 0; i < traj.size(); i++)
+				{
+					EXPECT_EQ(traj.times()[i], file.times()[i]);
+					EXPECT_EQ(traj.xs()[i], file.xs()[i]);
+					EXPECT_EQ(traj.headings()[i], file.headings()[i]);
+					EXPECT_EQ(traj.accelerations()[i], file.accelerations()[i]);
+				}
+				EXPECT_EQ(nullptr, file.column("missing"));
+			}
+
+			TEST(BinaryTrajectory, ReadFile)
+			{
+				PathTrajectory traj = makeTrajectory(500);
+				std::string name = "binarytrajectorytest.bin";
+
+				{
+					std::ofstream out(name, std::ios::out | std::ios::binary);
+					std::vector<std::string> headers = allHeaders();
+					ASSERT_TRUE(BinaryWriter::write<PathTrajectory::const_iterator>(out, headers, traj.begin(), traj.end()));
+				}
+
+				EXPECT_TRUE(BinaryTrajectoryReader::isBinary(name));
+
+				BinaryTrajectoryFile file;
+				ASSERT_TRUE(file.open(name)) << file.error();
+				EXPECT_EQ(500u, file.rows());
+				EXPECT_EQ(traj.velocities()[250], file.velocities()[250]);
+				file.close();
+
+				PathTrajectory back("main");
+				ASSERT_TRUE(BinaryTrajectoryReader::read(name, back));
+				ASSERT_EQ(traj.size(), back.size());
+				for (size_t i = 0; i < traj.size(); i++)
+				{
+					EXPECT_EQ(traj.times()[i], back.times()[i]);
+					EXPECT_EQ(traj.ys()[i], back.ys()[i]);
+					EXPECT_EQ(traj.positions()[i], back.positions()[i]);
+					EXPECT_EQ(traj.jerks()[i], back.jerks()[i]);
+					EXPECT_EQ(traj.curvatures()[i], back.curvatures()[i]);
+					EXPECT_EQ(traj.swrotations()[i], back.swrotations()[i]);
+					EXPECT_NEAR(traj.headings()[i], back.headings()[i], 1e-9);
+				}
+
+				std::remove(name.c_str());
+			}
+
+			TEST(BinaryTrajectory, RejectsBadFiles)
+			{
+				PathTrajectory traj = makeTrajectory(20);
+				std::string data = writeFile(traj, allHeaders());
+				std::vector<double> aligned(data.size() / sizeof(double) + 1);
+				BinaryTrajectoryFile file;
+
+				std::memcpy(aligned.data(), data.data(), data.size());
+				EXPECT_FALSE(file.attach(aligned.data(), data.size() - 8));
+				EXPECT_FALSE(file.attach(aligned.data(), 16));
+
+				char* bytes = reinterpret_cast<char*>(aligned.data());
+				bytes[8] = 2;
+				EXPECT_FALSE(file.attach(aligned.data(), data.size()));
+				EXPECT_FALSE(file.error().empty());
+
+				bytes[8] = 1;
+				bytes[0] = 'x';
+				EXPECT_FALSE(file.attach(aligned.data(), data.size()));
+				EXPECT_FALSE(file.isOpen());
+
+				bytes[0] = 'X';
+				EXPECT_TRUE(file.attach(aligned.data(), data.size()));
+			}
+
+			TEST(BinaryTrajectory, RequiredColumns)
+			{
+				PathTrajectory traj = makeTrajectory(5);
+				std::string name = "binarytrajectorytest2.bin";
+
+				{
+					std::ofstream out(name, std::ios::out | std::ios::binary);
+					std::vector<std::string> headers = { "time", "x", "y" };
+					BinaryWriter::write<PathTrajectory::const_iterator>(out, headers, traj.begin(), traj.end());
+				}
+
+				PathTrajectory back("main");
+				EXPECT_FALSE(BinaryTrajectoryReader::read(name, back));
+				std::remove(name.c_str());
+			}
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "TestPaths.h"
+#include <CSVTrajectoryReader.h>
+#include <CSVWriter.h>
+#include <cmath>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			TEST(CSVTrajectoryReader, ReadsWriterOutput)
+			{
+				PathTrajectory traj = makeTrajectory(100);
+				std::string text = writeTrajectory(traj, { "time", "x", "y", "position", "velocity", "acceleration", "jerk", "heading", "curvature" });
+
+				PathTrajectory read("main");
+				ASSERT_TRUE(CSVTrajectoryReader::parse(text, read));
+				ASSERT_EQ(traj.size(), read.size());
+
+				for (size_t i = 0; i < read.size(); i++)
+				{
+					EXPECT_NEAR(traj.times()[i], read.times()[i], 1e-4);
+					EXPECT_NEAR(traj.xs()[i], read.xs()[i], 1e-3);
+					EXPECT_NEAR(traj.ys()[i], read.ys()[i], 1e-3);
+					EXPECT_NEAR(traj.headings()[i], read.headings()[i], 1e-3);
+					EXPECT_NEAR(traj.velocities()[i], read.velocities()[i], 1e-3);
+					EXPECT_NEAR(traj.curvatures()[i], read.curvatures()[i], 1e-6);
+					EXPECT_EQ(0.0, read.swrotations()[i]);
+				}
+			}
+
+			TEST(CSVTrajectoryReader, MatchesLineParser)
+			{
+				std::string text = writeTrajectory(makeTrajectory(500), { "time", "x", "y", "position", "velocity", "acceleration", "jerk", "heading", "curvature" });
+
+				PathTrajectory fast("main"), slow("main");
+				ASSERT_TRUE(CSVTrajectoryReader::parse(text, fast));
+				ASSERT_TRUE(readByLine(text, slow));
+				ASSERT_EQ(slow.size(), fast.size());
+
+				for (size_t i = 0; i < slow.size(); i++)
+				{
+					EXPECT_EQ(slow[i].x(), fast[i].x());
+					EXPECT_EQ(slow[i].rotation().getCos(), fast[i].rotation().getCos());
+					EXPECT_EQ(slow[i].acceleration(), fast[i].acceleration());
+					EXPECT_EQ(slow[i].curvature(), fast[i].curvature());
+				}
+			}
+
+			TEST(CSVTrajectoryReader, RejectsBadInput)
+			{
+				PathTrajectory traj("main");
+
+				EXPECT_FALSE(CSVTrajectoryReader::parse("", traj));
+				EXPECT_FALSE(CSVTrajectoryReader::parse("\"time\",\"x\",\"y\"\n1,2,3\n", traj));
+
+				std::string headers = "\"time\",\"x\",\"y\",\"heading\",\"position\",\"velocity\",\"acceleration\",\"jerk\"\r\n";
+				EXPECT_FALSE(CSVTrajectoryReader::parse(headers + "1,2,3,4,5,6,7\r\n", traj));
+				EXPECT_FALSE(CSVTrajectoryReader::parse(headers + "1,2,3,4,5,6,7,abc\r\n", traj));
+				EXPECT_FALSE(CSVTrajectoryReader::parse(headers + "1,2,3,4,5,6,7,8,9\r\n", traj));
+
+				traj = PathTrajectory("main");
+				EXPECT_TRUE(CSVTrajectoryReader::parse(headers + "1,2,3,90,5,6,7,8\r\n0.5, +1e2,-3,0,nan,6,7,8", traj));
+				ASSERT_EQ(2u, traj.size());
+				EXPECT_EQ(100.0, traj.xs()[1]);
+				EXPECT_NEAR(1.0, traj.headingSin()[0], 1e-12);
+				EXPECT_TRUE(std::isnan(traj.positions()[1]));
+				EXPECT_EQ(0.0, traj.curvatures()[0]);
+			}
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "TestPaths.h"
+#include <DistanceView.h>
+#include <TrajectoryUtils.h>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static std::vector<Pose2d> makePoses()
+			{
+				//
+				// The first two splines of the sample path
+				//
+				std::vector<Pose2d> points = samplePoints();
+				points.resize(3);
+
+				return TrajectoryUtils::parameterize(makeSplines(points), 2.0, 0.05, 0.1);
+			}
+
+			static void expectSame(const Pose2dWithCurvature& a, const Pose2dWithCurvature& b)
+			{
+				EXPECT_EQ(a.getTranslation().getX(), b.getTranslation().getX());
+				EXPECT_EQ(a.getTranslation().getY(), b.getTranslation().getY());
+				EXPECT_EQ(a.getRotation().toRadians(), b.getRotation().toRadians());
+				EXPECT_EQ(a.curvature(), b.curvature());
+			}
+
+			TEST(DistanceView, CursorMatchesSearch)
+			{
+				DistanceView view(makePoses(), 1.0);
+				DistanceView::Cursor cursor = view.cursor();
+
+				for (double d = -1.0; d < view.length() + 2.0; d += 0.37)
+					expectSame(cursor[d], view[d]);
+
+				//
+				// Going backward must still find the right point
+				//
+				expectSame(cursor[view.length() / 3.0], view[view.length() / 3.0]);
+				expectSame(cursor[0.0], view[0.0]);
+				expectSame(cursor[view.getPosition(5)], view[view.getPosition(5)]);
+			}
+
+			TEST(DistanceView, Sample)
+			{
+				DistanceView view(makePoses(), 1.0);
+				std::vector<double> dists = { 0.0, 1.5, 10.25, 10.25, 3.0, view.length(), view.length() + 1.0 };
+				std::vector<Pose2dWithCurvature> results;
+
+				view.sample(dists, results);
+				ASSERT_EQ(dists.size(), results.size());
+				for (size_t i = 0; i < dists.size(); i++)
+					expectSame(results[i], view[dists[i]]);
+			}
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <JSONDocument.h>
+#include <JSON.h>
+#include <JSONValue.h>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			TEST(JSONDocument, Values)
+			{
+				JSONDocument doc;
+
+				ASSERT_TRUE(doc.parse("{ \"a\": 1.5, \"b\": [true, false, null, -2e3], \"c\": { \"d\": \"text\" }, \"e\": [] }"));
+
+				JSONDocument::Value root = doc.root();
+				ASSERT_TRUE(root.isObject());
+				EXPECT_EQ(4u, root.size());
+				EXPECT_DOUBLE_EQ(1.5, root["a"].asNumber());
+				EXPECT_EQ("b", root[1].key());
+
+				JSONDocument::Value b = root["b"];
+				ASSERT_TRUE(b.isArray());
+				ASSERT_EQ(4u, b.size());
+				EXPECT_TRUE(b[0].asBool());
+				EXPECT_TRUE(b[1].isBool());
+				EXPECT_FALSE(b[1].asBool());
+				EXPECT_TRUE(b[2].isNull());
+				EXPECT_DOUBLE_EQ(-2000.0, b[3].asNumber());
+				EXPECT_FALSE(b[4].isValid());
+
+				EXPECT_EQ("text", root["c"]["d"].asString());
+				EXPECT_TRUE(root["e"].isArray());
+				EXPECT_EQ(0u, root["e"].size());
+
+				EXPECT_FALSE(root.contains("missing"));
+				EXPECT_FALSE(root["missing"]["deeper"].isValid());
+			}
+
+			TEST(JSONDocument, Strings)
+			{
+				JSONDocument doc;
+
+				ASSERT_TRUE(doc.parse("[\"a\\\"b\\\\c\\/d\\n\", \"\\u00e9\\u20ac\", \"\\ud83d\\ude00\", \"caf\xc3\xa9\"]"));
+
+				JSONDocument::Value root = doc.root();
+				EXPECT_EQ("a\"b\\c/d\n", root[0].asString());
+				EXPECT_EQ("\xc3\xa9\xe2\x82\xac", root[1].asString());
+				EXPECT_EQ("\xf0\x9f\x98\x80", root[2].asString());
+				EXPECT_EQ("caf\xc3\xa9", root[3].asString());
+			}
+
+			TEST(JSONDocument, DuplicateKeys)
+			{
+				JSONDocument doc;
+
+				ASSERT_TRUE(doc.parse("{ \"x\": 1, \"x\": 2 }"));
+				EXPECT_DOUBLE_EQ(2.0, doc.root()["x"].asNumber());
+			}
+
+			TEST(JSONDocument, Errors)
+			{
+				const char* bad[] = { "", "{", "[1,]", "{\"a\" 1}", "{\"a\": 1,}", "01x", "1.", "\"abc", "tru", "[1] 2", "\"\\q\"" };
+
+				for (const char* text : bad)
+				{
+					JSONDocument doc;
+					EXPECT_FALSE(doc.parse(text)) << text;
+					EXPECT_FALSE(doc.error().empty());
+					EXPECT_FALSE(doc.root().isValid());
+				}
+			}
+		}
+	}
+}
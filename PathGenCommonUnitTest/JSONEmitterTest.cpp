@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <JSONEmitter.h>
+#include <cmath>
+#include <sstream>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			TEST(JSONEmitterTest, IndentedLayout)
+			{
+				std::stringstream strm;
+				OutputBuffer out;
+				JSONEmitter json(strm, out);
+
+				json.beginObject();
+				json.key("_version");
+				json.value(std::string("1"));
+				json.key("points");
+				json.beginArray();
+				json.beginObject();
+				json.key("time");
+				json.value(0.02);
+				json.key("x");
+				json.value(std::nan(""));
+				json.endObject();
+				json.endArray();
+				json.key("properities");
+				json.beginObject();
+				json.endObject();
+				json.endObject();
+				EXPECT_TRUE(json.finish());
+
+				const char* expected =
+					"{\n"
+					"    \"_version\": \"1\",\n"
+					"    \"points\": [\n"
+					"        {\n"
+					"            \"time\": 0.02,\n"
+					"            \"x\": null\n"
+					"        }\n"
+					"    ],\n"
+					"    \"properities\": {\n"
+					"    }\n"
+					"}\n";
+				EXPECT_EQ(expected, strm.str());
+			}
+
+			TEST(JSONEmitterTest, EscapesStrings)
+			{
+				std::stringstream strm;
+				OutputBuffer out;
+				JSONEmitter json(strm, out);
+
+				json.beginArray();
+				json.value(std::string("a\"b\\c\n\x01"));
+				json.endArray();
+				json.finish();
+
+				EXPECT_EQ("[\n    \"a\\\"b\\\\c\\n\\u0001\"\n]\n", strm.str());
+			}
+
+			TEST(JSONEmitterTest, BufferStaysSmall)
+			{
+				std::stringstream strm;
+				OutputBuffer out;
+				JSONEmitter json(strm, out, 4096);
+				size_t largest = 0;
+
+				json.beginArray();
+				for (int i = 0; i < 100000; i++)
+				{
+					json.beginObject();
+					json.key("time");
+					json.value(i * 0.02);
+					json.endObject();
+					largest = std::max(largest, out.size());
+				}
+				json.endArray();
+				json.finish();
+
+				EXPECT_LT(largest, 4096u + 256u);
+				EXPECT_GT(strm.str().size(), 100000u * 20u);
+			}
+		}
+	}
+}
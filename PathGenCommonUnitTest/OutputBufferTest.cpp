@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <OutputBuffer.h>
+#include <cstdlib>
+#include <sstream>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static const double values[] = { 0.0, -0.0, 1.0, -2.5, 0.1, 1.0 / 3.0, 123456.789, 1.0e-7, 6.02e23, -98.7654321 };
+
+			TEST(OutputBufferTest, GeneralMatchesStream)
+			{
+				for (double v : values)
+				{
+					OutputBuffer out;
+					std::stringstream strm;
+
+					out << v;
+					strm << v;
+					EXPECT_EQ(strm.str(), out.str());
+				}
+			}
+
+			TEST(OutputBufferTest, ShortestRoundTrips)
+			{
+				for (double v : values)
+				{
+					OutputBuffer out;
+					out.appendNumber(v, NumberFormat::Shortest, 0);
+					EXPECT_EQ(v, std::strtod(out.str().c_str(), nullptr));
+				}
+			}
+
+			TEST(OutputBufferTest, Fixed)
+			{
+				OutputBuffer out;
+				out.setNumberFormat(NumberFormat::Fixed, 3);
+				out << 1.0 / 3.0 << ',' << -2.0 << '\n';
+				EXPECT_EQ("0.333,-2.000\n", out.str());
+
+				std::stringstream strm;
+				EXPECT_TRUE(out.write(strm));
+				EXPECT_EQ(out.str(), strm.str());
+			}
+		}
+	}
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <PathTrajectory.h>
+#include <CSVWriter.h>
+#include <sstream>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static std::vector<Pose2dWithTrajectory> makePoints()
+			{
+				std::vector<Pose2dWithTrajectory> pts;
+				for (int i = 0; i < 10; i++)
+				{
+					Pose2d pose(Translation2d(i * 2.0, i * 0.5), Rotation2d::fromDegrees(i * 3.0));
+					pts.push_back(Pose2dWithTrajectory(pose, i * 0.02, i * 2.06, i * 1.5, 0.75, 0.0, 0.01 * i, 1.0 * i));
+				}
+				return pts;
+			}
+
+			TEST(PathTrajectory, ColumnsMatchPoints)
+			{
+				std::vector<Pose2dWithTrajectory> pts = makePoints();
+				PathTrajectory traj("main", pts);
+
+				ASSERT_EQ(pts.size(), traj.size());
+				for (size_t i = 0; i < pts.size(); i++)
+				{
+					EXPECT_EQ(pts[i].time(), traj.times()[i]);
+					EXPECT_EQ(pts[i].x(), traj.xs()[i]);
+					EXPECT_EQ(pts[i].y(), traj.ys()[i]);
+					EXPECT_EQ(pts[i].rotation().toDegrees(), traj.headings()[i]);
+					EXPECT_EQ(pts[i].position(), traj.positions()[i]);
+					EXPECT_EQ(pts[i].velocity(), traj.velocities()[i]);
+					EXPECT_EQ(pts[i].acceleration(), traj.accelerations()[i]);
+					EXPECT_EQ(pts[i].curvature(), traj.curvatures()[i]);
+					EXPECT_EQ(pts[i].swrotation(), traj.swrotations()[i]);
+				}
+			}
+
+			TEST(PathTrajectory, PointsRoundTrip)
+			{
+				std::vector<Pose2dWithTrajectory> pts = makePoints();
+				PathTrajectory traj("main", pts);
+
+				size_t i = 0;
+				for (const Pose2dWithTrajectory& pt : traj)
+				{
+					EXPECT_EQ(pts[i].rotation().getCos(), pt.rotation().getCos());
+					EXPECT_EQ(pts[i].rotation().getSin(), pt.rotation().getSin());
+					EXPECT_EQ(pts[i].jerk(), pt.jerk());
+					i++;
+				}
+				EXPECT_EQ(pts.size(), i);
+
+				traj.setSwRotation(3, 42.0);
+				EXPECT_EQ(42.0, traj[3].swrotation());
+			}
+
+			TEST(PathTrajectory, ColumnData)
+			{
+				PathTrajectory traj("main", makePoints());
+
+				double* x = traj.columnData(TrajectoryColumn::X);
+				ASSERT_NE(nullptr, x);
+				x[3] = 42.0;
+				EXPECT_EQ(42.0, traj.xs()[3]);
+				EXPECT_EQ(42.0, traj[3].x());
+
+				//
+				// The heading cannot be written in place, the rotation would not follow it
+				//
+				EXPECT_EQ(nullptr, traj.columnData(TrajectoryColumn::Heading));
+				EXPECT_EQ(nullptr, traj.columnData(TrajectoryColumn::Unknown));
+			}
+
+			TEST(PathTrajectory, CsvColumnsMatchFields)
+			{
+				std::vector<Pose2dWithTrajectory> pts = makePoints();
+				PathTrajectory traj("main", pts);
+				std::vector<std::string> headers = { "time", "x", "y", "heading", "position", "velocity", "acceleration", "jerk", "curvature", "rotation", "bogus" };
+
+				std::stringstream bycolumn, byfield;
+				CSVWriter::write<PathTrajectory::const_iterator>(bycolumn, headers, traj.begin(), traj.end());
+				CSVWriter::write<std::vector<Pose2dWithTrajectory>::const_iterator>(byfield, headers, pts.cbegin(), pts.cend());
+
+				EXPECT_EQ(byfield.str(), bycolumn.str());
+			}
+
+			TEST(PathTrajectory, TimeForDistance)
+			{
+				PathTrajectory traj("main", makePoints());
+				double time;
+
+				ASSERT_TRUE(traj.getTimeForDistance(2.06 * 2.5, time));
+				EXPECT_NEAR(0.05, time, 1e-12);
+
+				ASSERT_TRUE(traj.getTimeForDistance(1000.0, time));
+				EXPECT_EQ(traj.times().back(), time);
+
+				EXPECT_FALSE(traj.getTimeForDistance(-1.0, time));
+			}
+		}
+	}
+}
@@ -32,9 +32,12 @@ TEST(SCurveProfile, SimpleToMaxVel)
 TEST(SCurveProfile, SimpleLessMaxVel)
 {
 	//
-	// This profile does not have time for the robot to reach maximum velocity
+	// This profile does not have time for the robot to reach maximum velocity.  Both ramps
+	// reach the acceleration limit, so the distance is v * v / 120 + v / 10, which is 80
+	// for a peak velocity of sqrt(9636) - 6 and a time of 2 * (v / 120 + 0.1).
 	//
-	double time = 1.7404331140350879;
+	double time = 1.736052158907737;
+	double peak = 92.16312953446422;
 	double distance = 80.0;
 	double maxvel = 120.0;
 
@@ -48,11 +51,40 @@ TEST(SCurveProfile, SimpleLessMaxVel)
 
 	EXPECT_NEAR(time, profile.getTotalTime(), 1e-8);
 
-	EXPECT_NEAR(89.0625, profile.getVelocity(time / 2), 1e-8);
+	EXPECT_NEAR(peak, profile.getVelocity(time / 2), 1e-6);
+
+	time = profile.getTotalTime();
 
 	EXPECT_NEAR(distance, profile.getDistance(time), 1e-8);
 
 	EXPECT_NEAR(0.0, profile.getVelocity(time), 1e-8);
 
 	EXPECT_NEAR(0.0, profile.getAccel(time), 1e-8);
-}
\ No newline at end of file
+}
+
+TEST(SCurveProfile, StartAndEndVelocity)
+{
+	//
+	// This profile starts and ends moving and is too short to reach maximum velocity
+	//
+	double distance = 30.0;
+	double maxvel = 120.0;
+
+	// Max Jerk, Min Jerk, Max Accel, Min Accel, VelMax, VelMin
+	xero::paths::SCurveProfile profile(1200.0, -1200.0, 120.0, -120.0, maxvel, 10.0);
+
+	// Distance, Start Velocity, End Velocity
+	profile.update(distance, 20.0, 15.0);
+
+	double time = profile.getTotalTime();
+
+	EXPECT_NEAR(distance, profile.getTotalDistance(), 1e-8);
+
+	EXPECT_NEAR(distance, profile.getDistance(time), 1e-8);
+
+	EXPECT_NEAR(20.0, profile.getVelocity(0.0), 1e-8);
+
+	EXPECT_NEAR(15.0, profile.getVelocity(time), 1e-8);
+
+	EXPECT_LT(profile.getVelocity(time / 2), maxvel);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "TestPaths.h"
+#include <SplineOptimizer.h>
+#include <RobotPath.h>
+#include <Pose2d.h>
+#include <cmath>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static double sumDCurvature2(std::vector<SplinePair>& splines)
+			{
+				double sum = 0.0;
+				for (const SplinePair& pair : splines)
+					sum += pair.sumDCurvature2();
+
+				return sum;
+			}
+
+			TEST(SplineOptimizer, LowersCost)
+			{
+				std::vector<Pose2d> points = samplePoints();
+
+				auto splines = makeSplines(points);
+				double before = sumDCurvature2(splines);
+
+				SplineOptimizer opt;
+				double after = opt.optimize(splines);
+
+				EXPECT_GT(opt.iterations(), 0);
+				EXPECT_LT(after, before);
+				EXPECT_NEAR(after, sumDCurvature2(splines), 1e-12);
+
+				//
+				// The waypoints and the headings at the waypoints must not move
+				//
+				for (size_t i = 0; i < splines.size(); i++)
+				{
+					Pose2d start = splines[i].getStartPose();
+					Pose2d end = splines[i].getEndPose();
+					EXPECT_NEAR(points[i].getTranslation().getX(), start.getTranslation().getX(), 1e-9);
+					EXPECT_NEAR(points[i].getTranslation().getY(), start.getTranslation().getY(), 1e-9);
+					EXPECT_NEAR(points[i].getRotation().toDegrees(), start.getRotation().toDegrees(), 1e-6);
+					EXPECT_NEAR(points[i + 1].getTranslation().getX(), end.getTranslation().getX(), 1e-9);
+					EXPECT_NEAR(points[i + 1].getTranslation().getY(), end.getTranslation().getY(), 1e-9);
+				}
+
+				//
+				// The second derivatives must match where the splines meet
+				//
+				for (size_t i = 0; i < splines.size() - 1; i++)
+				{
+					EXPECT_DOUBLE_EQ(splines[i].ddx1(), splines[i + 1].ddx0());
+					EXPECT_DOUBLE_EQ(splines[i].ddy1(), splines[i + 1].ddy0());
+				}
+			}
+
+			TEST(SplineOptimizer, SingleSpline)
+			{
+				std::vector<Pose2d> points =
+				{
+					Pose2d(Translation2d(0.0, 0.0), Rotation2d::fromDegrees(0.0)),
+					Pose2d(Translation2d(100.0, 50.0), Rotation2d::fromDegrees(45.0)),
+				};
+
+				auto splines = makeSplines(points);
+				double before = sumDCurvature2(splines);
+
+				SplineOptimizer opt;
+				EXPECT_DOUBLE_EQ(before, opt.optimize(splines));
+				EXPECT_EQ(0, opt.iterations());
+			}
+
+			//
+			// Generating the splines for a path again, or optimizing splines of the same size with an
+			// optimizer that has been used before, must reuse the storage from the first time.
+			//
+			TEST(SplineOptimizer, ReusesStorage)
+			{
+				std::vector<Pose2d> points = samplePoints();
+
+				RobotPath path(nullptr, "reuse");
+				for (const Pose2d& pt : points)
+					path.addPoint(pt);
+
+				path.generateSplines();
+				const SplinePair* data = path.getSplines().data();
+				size_t capacity = path.getSplines().capacity();
+
+				path.generateSplines();
+				EXPECT_EQ(data, path.getSplines().data());
+				EXPECT_EQ(capacity, path.getSplines().capacity());
+
+				auto splines = makeSplines(points);
+				auto original = splines;
+				SplineOptimizer opt;
+
+				opt.optimize(splines);
+				capacity = opt.capacity();
+				EXPECT_GE(capacity, splines.size());
+
+				splines = original;
+				opt.optimize(splines);
+				EXPECT_EQ(capacity, opt.capacity());
+			}
+
+			TEST(SplineOptimizer, TooFewPoints)
+			{
+				RobotPath path(nullptr, "short");
+				path.generateSplines();
+				EXPECT_TRUE(path.getSplines().empty());
+
+				path.addPoint(Pose2d(Translation2d(0.0, 0.0), Rotation2d::fromDegrees(0.0)));
+				EXPECT_TRUE(path.getSplines().empty());
+			}
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "TestPaths.h"
+#include <SplinePair.h>
+#include <Pose2d.h>
+#include <cmath>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static std::vector<Pose2d> morePoints()
+			{
+				std::vector<Pose2d> points = samplePoints();
+				points.push_back(Pose2d(Translation2d(20.0, 60.0), Rotation2d::fromDegrees(-30.0)));
+				return points;
+			}
+
+			//
+			// Reference value for the integral, composite Simpson's rule with a very small step
+			//
+			static double referenceDCurvature2(SplinePair& pair)
+			{
+				const int n = 20000;
+				double h = 1.0 / n;
+				double sum = pair.getDCurvature2(0.0) + pair.getDCurvature2(1.0);
+				for (int i = 1; i < n; i++)
+					sum += ((i % 2) ? 4.0 : 2.0) * pair.getDCurvature2(i * h);
+
+				return sum * h / 3.0;
+			}
+
+			TEST(SplinePair, DCurvature2Accuracy)
+			{
+				auto points = morePoints();
+				for (size_t i = 0; i < points.size() - 1; i++)
+				{
+					SplinePair pair(points[i], points[i + 1]);
+					double ref = referenceDCurvature2(pair);
+					double gauss = pair.sumDCurvature2();
+					double sampled = pair.sumDCurvature2Sampled();
+
+					EXPECT_NEAR(gauss, ref, std::fabs(ref) * 1.0e-3);
+					EXPECT_LE(std::fabs(gauss - ref), std::fabs(sampled - ref));
+				}
+			}
+
+			TEST(SplinePair, EvalAll)
+			{
+				const size_t count = 64;
+				std::vector<double> ts(count);
+				std::vector<SplineSample> batch(count);
+
+				for (size_t i = 0; i < count; i++)
+					ts[i] = static_cast<double>(i) / (count - 1);
+
+				auto points = morePoints();
+				for (size_t i = 0; i < points.size() - 1; i++)
+				{
+					SplinePair pair(points[i], points[i + 1]);
+					pair.evalAll(ts.data(), batch.data(), count);
+
+					for (size_t j = 0; j < count; j++)
+					{
+						double t = ts[j];
+						SplineSample s = pair.evalAll(t);
+
+						EXPECT_DOUBLE_EQ(pair.getX().eval(t), s.v[0]);
+						EXPECT_DOUBLE_EQ(pair.getY().eval(t), s.v[1]);
+						EXPECT_DOUBLE_EQ(pair.getX().derivative(t), s.d1[0]);
+						EXPECT_DOUBLE_EQ(pair.getY().derivative(t), s.d1[1]);
+						EXPECT_DOUBLE_EQ(pair.getX().derivative2(t), s.d2[0]);
+						EXPECT_DOUBLE_EQ(pair.getY().derivative2(t), s.d2[1]);
+						EXPECT_DOUBLE_EQ(pair.getX().derivative3(t), s.d3[0]);
+						EXPECT_DOUBLE_EQ(pair.getY().derivative3(t), s.d3[1]);
+
+						EXPECT_DOUBLE_EQ(s.v[0], batch[j].v[0]);
+						EXPECT_DOUBLE_EQ(s.v[1], batch[j].v[1]);
+						EXPECT_DOUBLE_EQ(s.d3[0], batch[j].d3[0]);
+						EXPECT_DOUBLE_EQ(s.d3[1], batch[j].d3[1]);
+						EXPECT_DOUBLE_EQ(s.dcurvature2(), batch[j].dcurvature2());
+
+						EXPECT_NEAR(pair.evalHeading(t).toRadians(), s.heading().toRadians(), 1e-12);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <TankDriveModifier.h>
+#include <TrajectoryNames.h>
+#include <cmath>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static const double Radius = 100.0;
+			static const double Width = 24.0;
+			static const double Step = 0.01;
+			static const double Timestep = 0.02;
+
+			//
+			// A center trajectory driving counter clockwise around a circle at a constant speed
+			//
+			static std::shared_ptr<PathTrajectory> makeCircle(size_t n)
+			{
+				auto traj = std::make_shared<PathTrajectory>(TrajectoryName::Main);
+				double vel = Radius * Step / Timestep;
+
+				for (size_t i = 0; i < n; i++)
+				{
+					double a = i * Step;
+					traj->push_back(i * Timestep, Radius * std::cos(a), Radius * std::sin(a), Rotation2d::fromRadians(a + MathUtils::kPI / 2.0),
+						Radius * a, vel, 0.0, 0.0, 1.0 / Radius, 0.0);
+				}
+
+				return traj;
+			}
+
+			TEST(TankDriveModifier, CircleSides)
+			{
+				const size_t n = 50;
+				auto main = makeCircle(n);
+
+				std::vector<double> lx(n), ly(n), lpos(n), lvel(n), lacc(n), ljerk(n), lcurv(n);
+				std::vector<double> rx(n), ry(n), rpos(n), rvel(n), racc(n), rjerk(n), rcurv(n);
+				TankDriveModifier::SideColumns left = { lx.data(), ly.data(), lpos.data(), lvel.data(), lacc.data(), ljerk.data(), lcurv.data() };
+				TankDriveModifier::SideColumns right = { rx.data(), ry.data(), rpos.data(), rvel.data(), racc.data(), rjerk.data(), rcurv.data() };
+
+				TankDriveModifier::computeSides(n, Width, main->times().data(), main->xs().data(), main->ys().data(),
+					main->headingCos().data(), main->headingSin().data(), left, right);
+
+				//
+				// Turning left, the left side runs on the inside of the circle
+				//
+				double inner = Radius - Width / 2.0;
+				double outer = Radius + Width / 2.0;
+				double chord = 2.0 * std::sin(Step / 2.0);
+
+				for (size_t i = 0; i < n; i++)
+				{
+					EXPECT_NEAR(inner, std::hypot(lx[i], ly[i]), 1e-9);
+					EXPECT_NEAR(outer, std::hypot(rx[i], ry[i]), 1e-9);
+					EXPECT_NEAR(inner * chord * i, lpos[i], 1e-9);
+					EXPECT_NEAR(outer * chord * i, rpos[i], 1e-9);
+				}
+
+				EXPECT_EQ(0.0, lvel[0]);
+				EXPECT_EQ(0.0, rvel[0]);
+				EXPECT_EQ(0.0, lcurv[0]);
+				EXPECT_EQ(0.0, rcurv[n - 1]);
+
+				for (size_t i = 1; i < n; i++)
+				{
+					EXPECT_NEAR(inner * chord / Timestep, lvel[i], 1e-9);
+					EXPECT_NEAR(outer * chord / Timestep, rvel[i], 1e-9);
+				}
+
+				//
+				// The robot starts from rest, so there is an acceleration and jerk at the start only
+				//
+				EXPECT_NEAR(lvel[1] / Timestep, lacc[1], 1e-6);
+				EXPECT_NEAR(lacc[1] / Timestep, ljerk[1], 1e-6);
+				EXPECT_NEAR(-lacc[1] / Timestep, ljerk[2], 1e-6);
+				for (size_t i = 2; i < n; i++)
+				{
+					EXPECT_NEAR(0.0, lacc[i], 1e-6);
+					EXPECT_NEAR(0.0, racc[i], 1e-6);
+					if (i > 2)
+					{
+						EXPECT_NEAR(0.0, ljerk[i], 1e-4);
+						EXPECT_NEAR(0.0, rjerk[i], 1e-4);
+					}
+				}
+
+				for (size_t i = 1; i < n - 1; i++)
+				{
+					EXPECT_GT(lcurv[i], 0.0);
+					EXPECT_NEAR(outer / inner, lcurv[i] / rcurv[i], 1e-9);
+				}
+			}
+
+			TEST(TankDriveModifier, ModifyAddsSides)
+			{
+				const size_t n = 20;
+				auto path = std::make_shared<RobotPath>(nullptr, "circle");
+				path->addTrajectory(makeCircle(n));
+
+				RobotParams robot("robot");
+				robot.setEffectiveWidth(Width);
+
+				TankDriveModifier modifier;
+				ASSERT_TRUE(modifier.modify(robot, path, robot.getLengthUnits()));
+
+				auto main = path->getTrajectory(TrajectoryName::Main);
+				auto left = path->getTrajectory(TrajectoryName::Left);
+				auto right = path->getTrajectory(TrajectoryName::Right);
+				ASSERT_NE(nullptr, left);
+				ASSERT_NE(nullptr, right);
+				ASSERT_EQ(n, left->size());
+				ASSERT_EQ(n, right->size());
+
+				for (size_t i = 0; i < n; i++)
+				{
+					EXPECT_EQ(main->times()[i], left->times()[i]);
+					EXPECT_EQ(main->headings()[i], right->headings()[i]);
+					EXPECT_NEAR(Radius - Width / 2.0, std::hypot(left->xs()[i], left->ys()[i]), 1e-9);
+					EXPECT_NEAR(Radius + Width / 2.0, std::hypot(right->xs()[i], right->ys()[i]), 1e-9);
+					EXPECT_EQ(0.0, left->swrotations()[i]);
+				}
+			}
+		}
+	}
+}
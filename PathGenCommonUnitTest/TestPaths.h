@@ -0,0 +1,126 @@
+#pragma once
+
+#include <SplinePair.h>
+#include <PathTrajectory.h>
+#include <CSVWriter.h>
+#include <Pose2d.h>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//
+// Paths and trajectories shared by the unit tests and the benchmarks
+//
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			//
+			// Waypoints for a path with turns in both directions
+			//
+			inline std::vector<Pose2d> samplePoints()
+			{
+				return {
+					Pose2d(Translation2d(0.0, 0.0), Rotation2d::fromDegrees(0.0)),
+					Pose2d(Translation2d(100.0, 50.0), Rotation2d::fromDegrees(45.0)),
+					Pose2d(Translation2d(150.0, 150.0), Rotation2d::fromDegrees(90.0)),
+					Pose2d(Translation2d(100.0, 250.0), Rotation2d::fromDegrees(180.0)),
+					Pose2d(Translation2d(0.0, 200.0), Rotation2d::fromDegrees(-90.0)),
+				};
+			}
+
+			//
+			// The splines between each pair of waypoints, without optimizing them
+			//
+			inline std::vector<SplinePair> makeSplines(const std::vector<Pose2d>& points)
+			{
+				std::vector<SplinePair> splines;
+				for (size_t i = 0; i < points.size() - 1; i++)
+					splines.emplace_back(points[i], points[i + 1]);
+
+				return splines;
+			}
+
+			//
+			// A trajectory with every column changing from point to point
+			//
+			inline PathTrajectory makeTrajectory(size_t count)
+			{
+				PathTrajectory traj("main");
+				for (size_t i = 0; i < count; i++)
+				{
+					double t = i * 0.02;
+					Pose2d pose(Translation2d(std::cos(t) * 100.0, std::sin(t) * 50.0), Rotation2d::fromDegrees(i * 0.37));
+					traj.push_back(Pose2dWithTrajectory(pose, t, i * 1.1, 100.0 + std::sin(t), std::cos(t) * 30.0, -12.5, 0.001 * i, i * 0.5));
+				}
+				return traj;
+			}
+
+			inline std::string writeTrajectory(const PathTrajectory& traj, std::vector<std::string> headers)
+			{
+				std::stringstream strm;
+				CSVWriter::write<PathTrajectory::const_iterator>(strm, headers, traj.begin(), traj.end());
+				return strm.str();
+			}
+
+			//
+			// Line at a time parsing, the way the generator results were read before
+			//
+			inline bool readByLine(const std::string& text, PathTrajectory& traj)
+			{
+				std::stringstream in(text);
+				std::string line;
+				std::vector<std::string> headers;
+
+				auto split = [](const std::string& line, std::vector<std::string>& result) {
+					std::string word;
+					for (char ch : line)
+					{
+						if (ch == ',')
+						{
+							result.push_back(word);
+							word.clear();
+						}
+						else
+							word += ch;
+					}
+					result.push_back(word);
+				};
+
+				auto get = [&headers](const std::vector<double>& data, const char* name) {
+					for (size_t i = 0; i < headers.size(); i++)
+					{
+						if (headers[i] == name)
+							return data[i];
+					}
+					throw std::runtime_error("data element not found");
+				};
+
+				if (!std::getline(in, line))
+					return false;
+
+				split(line, headers);
+				for (std::string& header : headers)
+					header = header.substr(1, header.length() - 2);
+
+				while (std::getline(in, line))
+				{
+					std::vector<std::string> tokens;
+					std::vector<double> data;
+					split(line, tokens);
+					for (const std::string& token : tokens)
+						data.push_back(std::stod(token));
+
+					traj.push_back(get(data, "time"), get(data, "x"), get(data, "y"), Rotation2d::fromDegrees(get(data, "heading")),
+						get(data, "position"), get(data, "velocity"), get(data, "acceleration"), get(data, "jerk"), get(data, "curvature"), 0.0);
+				}
+
+				return true;
+			}
+		}
+	}
+}
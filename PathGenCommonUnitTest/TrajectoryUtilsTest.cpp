@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "TestPaths.h"
+#include <TrajectoryUtils.h>
+#include <cmath>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			TEST(TrajectoryUtils, ParameterizeWithinLimits)
+			{
+				const double maxdx = 2.0, maxdy = 0.05, maxdtheta = 0.1;
+				auto splines = makeSplines(samplePoints());
+				std::vector<Pose2d> poses = TrajectoryUtils::parameterize(splines, maxdx, maxdy, maxdtheta);
+
+				ASSERT_GT(poses.size(), splines.size());
+				Pose2d start = splines.front().getStartPose();
+				Pose2d end = splines.back().getEndPose();
+				EXPECT_NEAR(poses.front().getTranslation().getX(), start.getTranslation().getX(), 1e-9);
+				EXPECT_NEAR(poses.front().getTranslation().getY(), start.getTranslation().getY(), 1e-9);
+				EXPECT_NEAR(poses.back().getTranslation().getX(), end.getTranslation().getX(), 1e-9);
+				EXPECT_NEAR(poses.back().getTranslation().getY(), end.getTranslation().getY(), 1e-9);
+
+				for (size_t i = 1; i < poses.size(); i++)
+				{
+					Twist2d twist = Pose2d::logfn(poses[i - 1].inverse().transformBy(poses[i]));
+					EXPECT_LE(twist.getX(), maxdx + 1e-6);
+					EXPECT_LE(twist.getY(), maxdy + 1e-6);
+					EXPECT_LE(twist.getTheta(), maxdtheta + 1e-6);
+				}
+			}
+
+			TEST(TrajectoryUtils, ParallelMatchesSerial)
+			{
+				auto splines = makeSplines(samplePoints());
+				std::vector<Pose2d> serial = TrajectoryUtils::parameterize(splines, 2.0, 0.05, 0.1, false);
+				std::vector<Pose2d> parallel = TrajectoryUtils::parameterize(splines, 2.0, 0.05, 0.1, true);
+
+				ASSERT_EQ(serial.size(), parallel.size());
+				for (size_t i = 0; i < serial.size(); i++)
+				{
+					EXPECT_EQ(serial[i].getTranslation().getX(), parallel[i].getTranslation().getX());
+					EXPECT_EQ(serial[i].getTranslation().getY(), parallel[i].getTranslation().getY());
+					EXPECT_EQ(serial[i].getRotation().toRadians(), parallel[i].getRotation().toRadians());
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <XeroGenV1PathGenerator.h>
+#include <DistanceVelocityConstraint.h>
+
+namespace xero
+{
+	namespace paths
+	{
+		namespace test
+		{
+			static const double Timestep = 0.02;
+
+			//
+			// Generate a straight 100 inch path with a single distance velocity constraint
+			//
+			static std::shared_ptr<PathTrajectory> generateWithConstraint(bool scurve, double after, double before)
+			{
+				XeroGenV1PathGenerator gen(1.0, Timestep, scurve, 2.0, 0.05, 0.1, 10.0);
+				std::vector<Pose2d> points = { Pose2d(0.0, 0.0, Rotation2d::fromDegrees(0.0)), Pose2d(100.0, 0.0, Rotation2d::fromDegrees(0.0)) };
+				ConstraintCollection constraints;
+				constraints.push_back(std::make_shared<DistanceVelocityConstraint>(after, before, 60.0));
+
+				return gen.generate(points, constraints, 0.0, 0.0, 150.0, 150.0, 1500.0);
+			}
+
+			static void checkTrajectory(const PathTrajectory& traj)
+			{
+				ASSERT_GT(traj.size(), 1u);
+				for (size_t i = 1; i < traj.size(); i++)
+				{
+					EXPECT_GE(traj.times()[i], traj.times()[i - 1]);
+					EXPECT_GE(traj.positions()[i], traj.positions()[i - 1] - 1e-6);
+					EXPECT_LE(traj.velocities()[i], 150.0 + 1e-6);
+				}
+
+				EXPECT_NEAR(100.0, traj.positions()[traj.size() - 1], 0.5);
+				EXPECT_NEAR(0.0, traj.velocities()[traj.size() - 1], 1e-3);
+			}
+
+			TEST(XeroGenV1PathGenerator, ZeroWidthConstraint)
+			{
+				for (bool scurve : { true, false })
+				{
+					checkTrajectory(*generateWithConstraint(scurve, 30.0, 30.0));
+					checkTrajectory(*generateWithConstraint(scurve, 30.0, 30.000005));
+				}
+			}
+
+			TEST(XeroGenV1PathGenerator, ConstraintShorterThanTimestep)
+			{
+				for (bool scurve : { true, false })
+				{
+					auto traj = generateWithConstraint(scurve, 30.0, 30.1);
+					checkTrajectory(*traj);
+
+					//
+					// The path is limited to the constraint velocity while inside it
+					//
+					for (size_t i = 0; i < traj->size(); i++)
+					{
+						if (traj->positions()[i] > 30.0 && traj->positions()[i] < 30.1)
+						{
+							EXPECT_LE(traj->velocities()[i], 60.0 + 1e-3);
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -8,14 +8,23 @@
 #include "PathCollectionIO.h"
 #include "JSONWriter.h"
 #include "CSVWriter.h"
+#include "BinaryWriter.h"
 #include "JSONFlagsWriter.h"
 #include "CSVFlagsWriter.h"
 #include "build.h"
 #include <QtCore/QCoreApplication>
 #include <QStandardPaths>
 #include <QSettings>
+#include <JSONEmitter.h>
+#include <OutputBuffer.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
 #include <iostream>
 #include <list>
+#include <mutex>
+#include <thread>
 
 using namespace xero::paths;
 
@@ -25,6 +34,7 @@ static void usage()
 	std::cout << "options: --debug                  - prints debug information)" << std::endl;
 	std::cout << "         --csv                    - path trajectories are in CSV format" << std::endl;
 	std::cout << "         --json                   - path trajectories are in JSON format" << std::endl;
+	std::cout << "         --binary                 - path trajectories are in the binary format, flags are in CSV format" << std::endl;
 	std::cout << "         --outdir                 - output directory for all path trajectories" << std::endl;
 	std::cout << "         --generators directory   - adds the given directory to the list to search for generators" << std::endl;
 	std::cout << "         --robots directory       - adds the given directory to the list to search for robots" << std::endl;
@@ -32,14 +42,158 @@ static void usage()
 	std::cout << "         --robot name             - the name of the robot to use" << std::endl;
 	std::cout << "         --pathfile name          - the name of the pathfile to process" << std::endl;
 	std::cout << "         --units units            - the units to use, inches, feet, meters, cm, etc." << std::endl;
+	std::cout << "         --jobs count             - the number of paths generated at once, defaults to the number of cores" << std::endl;
+	std::cout << "         --summary file           - writes a JSON summary with the status and times for each path" << std::endl;
+	std::cout << "         --cachedir directory     - the directory for the cache of generated trajectories" << std::endl;
+	std::cout << "         --nocache                - generate every path, do not use the trajectory cache" << std::endl;
 	std::cout << "         --help                   - print this help information" << std::endl;
 }
 
+enum class OutputFormat
+{
+	CSV,
+	JSON,
+	Binary
+};
+
+//
+// Write the trajectories and flags for a path that has been generated
+//
+static void writePath(std::shared_ptr<RobotPath> path, OutputFormat format, const std::string& outdir)
+{
+	std::string outfile;
+	std::vector<std::string> names = path->getTrajectoryNames();
+
+	for (const std::string& trajname : names)
+	{
+		//
+		// Writre the paths to the last_path_dir directory as
+		// CSV files
+		//
+		if (format == OutputFormat::CSV)
+		{
+			outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".csv";
+		}
+		else if (format == OutputFormat::Binary)
+		{
+			outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".bin";
+		}
+		else
+		{
+			outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".json";
+		}
+
+		std::ofstream outstrm(outfile, format == OutputFormat::Binary ? std::ios::out | std::ios::binary : std::ios::out);
+
+		std::vector<std::string> headers =
+		{
+			RobotPath::TimeTag,
+			RobotPath::XTag,
+			RobotPath::YTag,
+			RobotPath::PositionTag,
+			RobotPath::VelocityTag,
+			RobotPath::AccelerationTag,
+			RobotPath::JerkTag,
+			RobotPath::HeadingTag
+		};
+
+		auto t = path->getTrajectory(trajname);
+		if (format == OutputFormat::CSV)
+		{
+			CSVWriter::write<PathTrajectory::const_iterator>(outstrm, headers, t->begin(), t->end());
+		}
+		else if (format == OutputFormat::Binary)
+		{
+			BinaryWriter::write<PathTrajectory::const_iterator>(outstrm, headers, t->begin(), t->end());
+		}
+		else
+		{
+			JSONWriter::write<PathTrajectory::const_iterator>(outstrm, headers, t->begin(), t->end(), path->props());
+		}
+	}
+
+	if (path->getFlags().size() > 0)
+	{
+		if (format != OutputFormat::JSON)
+		{
+			outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_flags.csv";
+			CSVFlagsWriter::writeFlags(path, outfile);
+		}
+		else
+		{
+			outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_flags.json";
+			JSONFlagsWriter::writeFlags(path, outfile);
+		}
+	}
+}
+
+//
+// One line of the summary, for each path in the order the paths finished
+//
+struct PathSummary
+{
+	std::string group_;
+	std::string name_;
+	std::string status_;
+	double generate_;
+	double write_;
+	double length_;
+	double time_;
+};
+
+//
+// Write a JSON summary of the run, so a script can tell which paths failed and
+// where the time went
+//
+static bool writeSummary(const std::string& filename, size_t jobs, double elapsed, const std::list<PathSummary>& summary)
+{
+	std::ofstream strm(filename);
+	if (!strm.is_open())
+		return false;
+
+	OutputBuffer out;
+	JSONEmitter json(strm, out);
+
+	json.beginObject();
+	json.key("jobs");
+	json.value(static_cast<double>(jobs));
+	json.key("elapsed");
+	json.value(elapsed);
+	json.key("paths");
+	json.beginArray();
+	for (const PathSummary& one : summary)
+	{
+		json.beginObject();
+		json.key("group");
+		json.value(one.group_);
+		json.key("name");
+		json.value(one.name_);
+		json.key("status");
+		json.value(one.status_);
+		json.key("generate");
+		json.value(one.generate_);
+		json.key("write");
+		json.value(one.write_);
+		json.key("length");
+		json.value(one.length_);
+		json.key("time");
+		json.value(one.time_);
+		json.endObject();
+	}
+	json.endArray();
+	json.endObject();
+
+	return json.finish();
+}
+
 int main(int argc, char *argv[])
 {
 	bool debug = false;
-	bool csv = true;
+	OutputFormat format = OutputFormat::CSV;
 	bool help = false;
+	bool nocache = false;
+	size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+	std::string summaryfile;
 	QCoreApplication::setOrganizationName("ErrorCodeXero");
 	QCoreApplication::setOrganizationDomain("www.wilsonvillerobotics.com");
 	QCoreApplication::setApplicationName("XeroPathGenerator");
@@ -65,6 +219,7 @@ int main(int argc, char *argv[])
 	std::string generatorname;
 	std::string pathfile;
 	std::string units = "in";
+	QString cachedir;
 
 	std::cout << "PathGenerator Version ";
 	std::cout << XERO_MAJOR_VERSION << "." << XERO_MINOR_VERSION << ".";
@@ -82,11 +237,15 @@ int main(int argc, char *argv[])
 		}
 		else if (arg == "--csv")
 		{
-			csv = true;
+			format = OutputFormat::CSV;
 		}
 		else if (arg == "--json")
 		{
-			csv = false;
+			format = OutputFormat::JSON;
+		}
+		else if (arg == "--binary")
+		{
+			format = OutputFormat::Binary;
 		}
 		else if (arg == "--units")
 		{
@@ -163,6 +322,67 @@ int main(int argc, char *argv[])
 			pathfile = *argv++;
 			argc--;
 		}
+		else if (arg == "--jobs")
+		{
+			if (argc == 0)
+			{
+				std::cerr << "error: --jobs flag requires count argument" << std::endl;
+				return 1;
+			}
+
+			std::string str = *argv++;
+			argc--;
+
+			int count;
+			size_t index;
+			try {
+				count = std::stoi(str, &index);
+			}
+			catch (...)
+			{
+				std::cerr << "error: --jobs flag requires an integer count argument" << std::endl;
+				return 1;
+			}
+
+			if (index != str.length())
+			{
+				std::cerr << "error: --jobs flag requires an integer count argument" << std::endl;
+				return 1;
+			}
+
+			if (count < 1)
+			{
+				std::cerr << "error: --jobs flag requires a count of at least one" << std::endl;
+				return 1;
+			}
+			jobs = static_cast<size_t>(count);
+		}
+		else if (arg == "--summary")
+		{
+			if (argc == 0)
+			{
+				std::cerr << "error: --summary flag requires file argument" << std::endl;
+				return 1;
+			}
+
+			summaryfile = *argv++;
+			argc--;
+		}
+		else if (arg == "--cachedir")
+		{
+			if (argc == 0)
+			{
+				std::cerr << "--cachedir flag requires path argument" << std::endl;
+				return 1;
+			}
+
+			cachedir = *argv++;
+			argc--;
+		}
+		else if (arg == "--nocache")
+		{
+			nocache = true;
+		}
 		else if (arg == "--help")
 		{
 			help = true;
@@ -227,6 +447,7 @@ int main(int argc, char *argv[])
 	}
 
 	engine.setUnits(units);
+	engine.setParallel(jobs);
 	engine.setGenerator(generator);
 	engine.setRobot(robot);
 	QString keyname = QString("generator/") + generator->getName().c_str();
@@ -234,6 +455,16 @@ int main(int argc, char *argv[])
 	store.assignValues(value.toHash());
 	engine.setGeneratorStore(store);
 
+	if (cachedir.length() == 0)
+	{
+		cachedir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+		if (cachedir.length() > 0)
+			cachedir += "/trajectories";
+	}
+
+	if (!nocache && cachedir.length() > 0)
+		engine.setCache(std::make_shared<TrajectoryCache>(cachedir));
+
 	//
 	// TODO - add paths to the generator
 	//
@@ -244,79 +475,110 @@ int main(int argc, char *argv[])
 	std::list<std::shared_ptr<RobotPath>> pathlist;
 	paths.getAllPaths(pathlist);
 
+	//
+	// The engine tells us as each path is done, and this thread writes the path while
+	// the engine threads go on to the next ones
+	//
+	std::mutex complete_lock;
+	std::condition_variable complete_cv;
+	size_t published = 0;
+
+	engine.setCompleteCallback([&complete_lock, &complete_cv, &published](std::shared_ptr<RobotPath> path) {
+		(void)path;
+		std::lock_guard<std::mutex> guard(complete_lock);
+		published++;
+		complete_cv.notify_one();
+	});
+
+	auto start = std::chrono::steady_clock::now();
+
 	for(auto path : pathlist)
 		engine.markPathDirty(path);
 
-	int pending;
-	std::chrono::milliseconds delay(250);
-	do {
-		pending = static_cast<int>(engine.waitingPaths());
-		std::this_thread::sleep_for(delay);
-	} while (pending > 0);
-
-	engine.stopAll();
+	std::list<PathSummary> summary;
+	size_t written = 0;
+	int failed = 0;
 
-	std::string outfile;
 	std::cout << "Processing paths ..." << std::endl;
-	for (auto path : pathlist)
+	while (written < pathlist.size())
 	{
-		std::cout << "  path '" << path->getName() << "' " << std::flush;
-		std::vector<std::string> names = path->getTrajectoryNames();
-		for (const std::string& trajname : names)
-		{
-			//
-			// Writre the paths to the last_path_dir directory as
-			// CSV files
-			//
-			if (csv)
-			{
-				outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".csv";
-			}
-			else
-			{
-				outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".json";
-			}
+		std::shared_ptr<RobotPath> path = engine.getComplete();
+		if (path == nullptr)
+		{
+			std::unique_lock<std::mutex> lock(complete_lock);
+			complete_cv.wait(lock, [&published, &written] { return published > written; });
+			continue;
+		}
 
-			std::ofstream outstrm(outfile);
+		written++;
 
-			std::vector<std::string> headers =
-			{
-				RobotPath::TimeTag,
-				RobotPath::XTag,
-				RobotPath::YTag,
-				RobotPath::PositionTag,
-				RobotPath::VelocityTag,
-				RobotPath::AccelerationTag,
-				RobotPath::JerkTag,
-				RobotPath::HeadingTag
-			};
-
-			auto t = path->getTrajectory(trajname);
-			if (csv)
-			{
-				CSVWriter::write<std::vector<Pose2dWithTrajectory>::const_iterator>(outstrm, headers, t->begin(), t->end());
-			}
-			else
-			{
-				JSONWriter::write<std::vector<Pose2dWithTrajectory>::const_iterator>(outstrm, headers, t->begin(), t->end());
-			}
+		PathGenerationEngine::PathStatus status;
+		if (!engine.getStatus(path, status))
+		{
+			status.ok_ = false;
+			status.cached_ = false;
+			status.elapsed_ = std::chrono::duration<double>::zero();
 		}
 
-		if (path->getFlags().size() > 0)
+		PathSummary one;
+		one.group_ = path->getParent()->getName();
+		one.name_ = path->getName();
+		one.generate_ = status.elapsed_.count();
+
+		std::cout << "  path '" << path->getName() << "' " << std::flush;
+
+		//
+		// A path that failed is not written, so no trajectory files are left that look usable
+		//
+		std::chrono::duration<double> wtime = std::chrono::duration<double>::zero();
+		if (status.ok_)
 		{
-			if (csv)
-			{
-				outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_flags.csv";
-				CSVFlagsWriter::writeFlags(path, outfile);
-			}
-			else
-			{
-				outfile = outdir + "/" + path->getParent()->getName() + "_" + path->getName() + "_flags.json";
-				JSONFlagsWriter::writeFlags(path, outfile);
-			}
+			auto wstart = std::chrono::steady_clock::now();
+			writePath(path, format, outdir);
+			wtime = std::chrono::steady_clock::now() - wstart;
+		}
+
+		if (!status.ok_)
+		{
+			one.status_ = "failed";
+			failed++;
+		}
+		else if (status.cached_)
+		{
+			one.status_ = "cached";
 		}
-		std::cout << ", length " << path->getDistance() << ", time " << path->getTime() << std::endl;
+		else
+		{
+			one.status_ = "generated";
+		}
+
+		one.write_ = wtime.count();
+		one.length_ = path->getDistance();
+		one.time_ = path->getTime();
+		std::cout << ", length " << one.length_ << ", time " << one.time_;
+		if (!status.ok_)
+			std::cout << ", failed";
+		std::cout << std::endl;
+
+		summary.push_back(one);
+	}
+
+	engine.stopAll();
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::cout << pathlist.size() << " paths, " << failed << " failed, " << elapsed.count() << " seconds, " << jobs << " jobs" << std::endl;
+
+	if (summaryfile.length() > 0 && !writeSummary(summaryfile, jobs, elapsed.count(), summary))
+	{
+		std::cerr << "error: could not write summary file '" << summaryfile << "'" << std::endl;
+		return 1;
 	}
 
+	//
+	// The same exit code the generators use when a path cannot be generated
+	//
+	if (failed > 0)
+		return 99;
+
 	return 0;
 }
@@ -22,14 +22,14 @@ CheesyGenerator::~CheesyGenerator()
 {
 }
 
-std::vector<std::shared_ptr<xero::paths::SplinePair>>
+std::vector<xero::paths::SplinePair>
 CheesyGenerator::generateSplines(const std::vector<xero::paths::Pose2d>& points)
 {
 	RobotPath path(nullptr, "");
 	for (const Pose2d& pt : points)
 		path.addPoint(pt);
 	path.generateSplines();
-	return path.getSplines();
+	return std::move(path.getSplines());
 }
 
 std::vector<xero::paths::Pose2dWithTrajectory>
@@ -40,6 +40,7 @@ CheesyGenerator::timeParameterize(const DistanceView& view, const xero::paths::C
 	Pose2dConstrained predecessor;
 	const static double kEpsilon = 1e-6;
 
+	points.reserve(view.size());
 	predecessor.setPosition(0.0);
 	predecessor.setPose(view[static_cast<size_t>(0)]);
 	predecessor.setVelocity(startvel);
@@ -51,9 +52,10 @@ CheesyGenerator::timeParameterize(const DistanceView& view, const xero::paths::C
 	//
 	for (size_t i = 0; i < view.size(); i++)
 	{
+		const Pose2dWithCurvature& pt = view[i];
 		Pose2dConstrained state;
-		state.setPose(view[i]);
-		state.setCurvature(view[i].curvature());
+		state.setPose(pt);
+		state.setCurvature(pt.curvature());
 		state.setPosition(view.getPosition(i));
 
 		double dist = predecessor.pose().distance(state.pose());
@@ -159,6 +161,7 @@ CheesyGenerator::timeParameterize(const DistanceView& view, const xero::paths::C
 	double v = 0.0;
 	std::vector<xero::paths::Pose2dWithTrajectory> result;
 
+	result.reserve(points.size());
 	for (size_t i = 0; i < points.size(); i++)
 	{
 		const Pose2dConstrained& state = points[i];
@@ -245,12 +248,19 @@ std::vector<xero::paths::Pose2dWithTrajectory> CheesyGenerator::convertToUniform
 std::shared_ptr<xero::paths::PathTrajectory> 
 CheesyGenerator::generate(const std::vector<xero::paths::Pose2d>& waypoints, const xero::paths::ConstraintCollection& constraints,
 	double startvel, double endvel, double maxvel, double maxaccel, double maxjerk)
+{
+	std::shared_ptr<DistanceView> distview = prepare(waypoints);
+	return generate(*distview, constraints, startvel, endvel, maxvel, maxaccel, maxjerk);
+}
+
+std::shared_ptr<DistanceView>
+CheesyGenerator::prepare(const std::vector<xero::paths::Pose2d>& waypoints)
 {
 	//
 	// Step 1: generate a set of splines that represent the path
 	//         (taken from the cheesy poofs code)
 	//
-	std::vector<std::shared_ptr<xero::paths::SplinePair>> splines = generateSplines(waypoints);
+	std::vector<xero::paths::SplinePair> splines = generateSplines(waypoints);
 
 	//
 	// Step 2: generate a set of points that represent the path where the curvature, x, and y do not 
@@ -262,8 +272,13 @@ CheesyGenerator::generate(const std::vector<xero::paths::Pose2d>& waypoints, con
 	//
 	// Step 3: generate a set of points that are equi-distant apart (diststep_).
 	//
-	DistanceView distview(paramtraj, diststep_);
+	return std::make_shared<DistanceView>(paramtraj, diststep_);
+}
 
+std::shared_ptr<PathTrajectory>
+CheesyGenerator::generate(const DistanceView& distview, const xero::paths::ConstraintCollection& constraints,
+	double startvel, double endvel, double maxvel, double maxaccel, double maxjerk)
+{
 	//
 	// Step 4: generate a timing view that meets the constraints of the system
 	//
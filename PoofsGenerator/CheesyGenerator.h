@@ -16,8 +16,16 @@ public:
 	std::shared_ptr<xero::paths::PathTrajectory> generate(const std::vector<xero::paths::Pose2d>& waypoints, const xero::paths::ConstraintCollection& constraints,
 		double startvel, double endvel, double maxvel, double maxaccel, double maxjerk);
 
+	//
+	// The waypoint dependent steps of generate(), and the velocity dependent steps, so the
+	// splines are only computed once when a path is generated with several velocity limits
+	//
+	std::shared_ptr<xero::paths::DistanceView> prepare(const std::vector<xero::paths::Pose2d>& waypoints);
+	std::shared_ptr<xero::paths::PathTrajectory> generate(const xero::paths::DistanceView& distview, const xero::paths::ConstraintCollection& constraints,
+		double startvel, double endvel, double maxvel, double maxaccel, double maxjerk);
+
 private:
-	std::vector<std::shared_ptr<xero::paths::SplinePair>> generateSplines(const std::vector<xero::paths::Pose2d>& points);
+	std::vector<xero::paths::SplinePair> generateSplines(const std::vector<xero::paths::Pose2d>& points);
 	std::vector<xero::paths::Pose2dWithTrajectory> timeParameterize(const xero::paths::DistanceView& view, const xero::paths::ConstraintCollection& constraints, 
 					double startvel, double endvel, double maxvel, double maxaccel);
 
@@ -1,10 +1,13 @@
 #include "JSONPathReader.h"
 #include "PathCollection.h"
+#include "PathBatch.h"
 #include "CSVWriter.h"
+#include "BinaryWriter.h"
 #include "PathTrajectory.h"
 #include "CheesyGenerator.h"
 #include "CentripetalAccelerationConstraint.h"
 #include <iostream>
+#include <stdexcept>
 
 using namespace xero::paths;
 
@@ -15,6 +18,9 @@ static constexpr double kMaxDTheta = 0.1; //radians!
 std::string pathfile;
 std::string robotfile;
 std::string outfile;
+std::string outdir;
+size_t jobs = 0;
+bool binary = false;
 std::string units = "in";
 double timestep = 0.02;
 double diststep = 1.0;
@@ -28,8 +34,7 @@ bool maxdxgiven = false;
 bool maxdygiven = false;
 bool diststepgiven = false;
 
-extern void generateForGroup(const std::string& group, const RobotParams& robot);
-extern void generateForPath(PathGroup& group, const std::string& path, const RobotParams& robot);
+extern void generateForPath(PathBatch& batch, PathGroup& group, RobotPath& path, const RobotParams& robot);
 
 int main(int ac, char** av)
 {
@@ -193,6 +198,45 @@ int main(int ac, char** av)
 			robotfile = *av++;
 			ac--;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
+		else if (arg == "--outdir")
+		{
+			if (ac == 0) {
+				std::cerr << "PoofsGen: expected directory name following --outdir argument" << std::endl;
+				return 1;
+			}
+
+			outdir = *av++;
+			ac--;
+		}
+		else if (arg == "--jobs")
+		{
+			if (ac == 0) {
+				std::cerr << "PoofsGen: expected integer number following --jobs argument" << std::endl;
+				return 1;
+			}
+
+			arg = *av;
+			try {
+				jobs = std::stoul(arg, &index);
+			}
+			catch (...)
+			{
+				std::cerr << "PoofsGen: expected integer number following --jobs argument" << std::endl;
+				return 1;
+			}
+
+			if (index != arg.length() || jobs == 0)
+			{
+				std::cerr << "PoofsGen: expected integer number following --jobs argument" << std::endl;
+				return 1;
+			}
+			ac--;
+			av++;
+		}
 		else if (arg == "--outfile")
 		{
 			if (ac == 0) {
@@ -252,47 +296,35 @@ int main(int ac, char** av)
 		diststep = xero::paths::UnitConverter::convert(diststep, units, robot.getLengthUnits());
 	}
 
-	if (collection.getPathCount() != 1) {
-		std::cerr << "CheesyGen: can only process a single path in the paths file" << std::endl;
+	//
+	// A single path can go to the output file, any number of paths can go to an output
+	// directory, one file for each path
+	//
+	if (outdir.length() == 0 && collection.getPathCount() != 1) {
+		std::cerr << "PoofsGen: can only process a single path in the paths file without --outdir" << std::endl;
 		return 1;
 	}
 
-	try {
-		std::vector<std::string> groups = collection.getGroupNames();
-		for (const std::string& group : groups)
-			generateForGroup(group, robot);
-	}
-	catch (const std::runtime_error&ex)
-	{
-		std::cerr << "ERROR: " << ex.what() << std::endl;
-		exit(99);
-	}
-}
+	if (jobs == 0)
+		jobs = PathBatch::defaultThreads();
 
-void generateForGroup(const std::string& group, const RobotParams &robot)
-{
-	auto gptr = collection.getGroupByName(group);
-	if (gptr == nullptr)
+	PathBatch batch(collection);
+	if (batch.run(jobs, [&batch, &robot](PathGroup& group, RobotPath& path) { generateForPath(batch, group, path, robot); }) > 0)
 	{
-		std::cerr << "PoofsGen: warning: path group '" << group << "' does not exist" << std::endl;
-		return;
+		for (const std::string& err : batch.errors())
+			std::cerr << "ERROR: " << err << std::endl;
+
+		return 99;
 	}
 
-	std::cout << "Generating paths for group " << group << " ... " << std::endl;
-	std::vector<std::string> paths = gptr->getPathNames();
-	for (const std::string& path : paths)
-		generateForPath(*gptr, path, robot);
+	return 0;
 }
 
-void generateForPath(PathGroup& group, const std::string& path, const RobotParams& robot)
+void generateForPath(PathBatch& batch, PathGroup& group, RobotPath& path, const RobotParams& robot)
 {
-	std::cout << "  Generating paths for path " << path << " ... " << std::endl;
-	auto pptr = group.findPathByName(path);
-	if (pptr == nullptr)
 	{
-		std::cerr << "PoofsGen: warning: path '" << path << "' does not exist in group '";
-		std::cerr << group.getName() << "'" << std::endl;
-		return;
+		std::lock_guard<std::mutex> guard(batch.consoleLock());
+		std::cout << "  Generating paths for path " << group.getName() << "/" << path.getName() << " ... " << std::endl;
 	}
 
 	//
@@ -301,13 +333,13 @@ void generateForPath(PathGroup& group, const std::string& path, const RobotParam
 	// values.
 	//
 	std::shared_ptr<PathTrajectory> trajectory;
-	ConstraintCollection constraints = pptr->getConstraints();
+	ConstraintCollection constraints = path.getConstraints();
 
-	constraints.push_back(std::make_shared< CentripetalAccelerationConstraint>(pptr->getMaxCentripetal(), robot.getRobotWeight(), robot.getLengthUnits(), robot.getWeightUnits()));
+	constraints.push_back(std::make_shared< CentripetalAccelerationConstraint>(path.getMaxCentripetal(), robot.getRobotWeight(), robot.getLengthUnits(), robot.getWeightUnits()));
 
 	CheesyGenerator gen(diststep, timestep, maxdx, maxdy, maxtheta);
-	trajectory = gen.generate(pptr->getPoints(), constraints, pptr->getStartVelocity(),
-		pptr->getEndVelocity(), pptr->getMaxVelocity(), pptr->getMaxAccel(), pptr->getMaxJerk());
+	trajectory = gen.generate(path.getPoints(), constraints, path.getStartVelocity(),
+		path.getEndVelocity(), path.getMaxVelocity(), path.getMaxAccel(), path.getMaxJerk());
 
 	std::vector<std::string> headers =
 	{
@@ -322,11 +354,16 @@ void generateForPath(PathGroup& group, const std::string& path, const RobotParam
 		RobotPath::CurvatureTag
 	};
 
-	std::ofstream strm(outfile);
+	std::string filename = outfile;
+	if (outdir.length() > 0)
+		filename = PathBatch::outputFile(outdir, group, path, binary ? ".bin" : ".csv");
+
+	std::ofstream strm(filename, binary ? std::ios::out | std::ios::binary : std::ios::out);
 	if (!strm.is_open())
-	{
-		std::cerr << "PoofsGen: could not open file '" << outfile << "' for writing." << std::endl;
-		return;
-	}
-	CSVWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory->begin(), trajectory->end());
+		throw std::runtime_error("could not open file '" + filename + "' for writing");
+
+	if (binary)
+		BinaryWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory->begin(), trajectory->end());
+	else
+		CSVWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory->begin(), trajectory->end());
 }
@@ -0,0 +1,96 @@
+#include "CheesyGenerator.h"
+#include "CentripetalAccelerationConstraint.h"
+#include <GeneratorPlugin.h>
+#include <UnitConverter.h>
+
+using namespace xero::paths;
+
+//
+// A path prepared once, and generated for each set of velocity limits
+//
+class PoofsSession : public GeneratorSession
+{
+public:
+	PoofsSession(const CheesyGenerator& gen, const RobotPath& path, const ConstraintCollection &constraints) : gen_(gen) {
+		distview_ = gen_.prepare(path.getPoints());
+		constraints_ = constraints;
+		startvel_ = path.getStartVelocity();
+		endvel_ = path.getEndVelocity();
+		maxjerk_ = path.getMaxJerk();
+	}
+
+	virtual ~PoofsSession() {
+	}
+
+	virtual std::shared_ptr<PathTrajectory> generate(double maxvel, double maxaccel) {
+		return gen_.generate(*distview_, constraints_, startvel_, endvel_, maxvel, maxaccel, maxjerk_);
+	}
+
+private:
+	CheesyGenerator gen_;
+	std::shared_ptr<DistanceView> distview_;
+	ConstraintCollection constraints_;
+	double startvel_;
+	double endvel_;
+	double maxjerk_;
+};
+
+//
+// In process version of the PoofsGenerator program.  The defaults and the arguments
+// match the command line arguments processed in PoofsGenerator.cpp.
+//
+class PoofsPlugin : public GeneratorPlugin
+{
+public:
+	PoofsPlugin() {
+	}
+
+	virtual ~PoofsPlugin() {
+	}
+
+	virtual std::shared_ptr<PathTrajectory> generate(const RobotParams& robot, const RobotPath& path,
+		double maxvel, double maxaccel, const std::vector<std::string>& args)
+	{
+		return createSession(robot, path, args)->generate(maxvel, maxaccel);
+	}
+
+	virtual std::shared_ptr<GeneratorSession> createSession(const RobotParams& robot, const RobotPath& path,
+		const std::vector<std::string>& args)
+	{
+		std::string units = "in";
+		double timestep = robot.getTimestep();
+		double diststep = 1.0;
+		double maxdx = kMaxDX;
+		double maxdy = kMaxDY;
+		double maxtheta = kMaxDTheta;
+
+		getStringArg(args, "--units", units);
+		getDoubleArg(args, "--timestep", timestep);
+		getDoubleArg(args, "--maxtheta", maxtheta);
+
+		//
+		// Deal with defaults
+		//
+		if (!getDoubleArg(args, "--maxdx", maxdx))
+			maxdx = UnitConverter::convert(maxdx, units, robot.getLengthUnits());
+
+		if (!getDoubleArg(args, "--maxdy", maxdy))
+			maxdy = UnitConverter::convert(maxdy, units, robot.getLengthUnits());
+
+		if (!getDoubleArg(args, "--diststep", diststep))
+			diststep = UnitConverter::convert(diststep, units, robot.getLengthUnits());
+
+		ConstraintCollection constraints = path.getConstraints();
+		constraints.push_back(std::make_shared<CentripetalAccelerationConstraint>(path.getMaxCentripetal(), robot.getRobotWeight(), robot.getLengthUnits(), robot.getWeightUnits()));
+
+		CheesyGenerator gen(diststep, timestep, maxdx, maxdy, maxtheta);
+		return std::make_shared<PoofsSession>(gen, path, constraints);
+	}
+
+private:
+	static constexpr double kMaxDX = 2.0; //inches
+	static constexpr double kMaxDY = 0.05; //inches
+	static constexpr double kMaxDTheta = 0.1; //radians!
+};
+
+XERO_GENERATOR_PLUGIN(PoofsPlugin)
@@ -1,6 +1,7 @@
 #include "PathVelocitySegment.h"
 #include <SCurveProfile.h>
 #include <TrapezoidalProfile.h>
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 
@@ -24,7 +25,12 @@ bool PathVelocitySegment::createProfile(bool scurve, double maxjerk, double maxa
 
 	if (scurve)
 	{
-		profile_ = std::make_shared<SCurveProfile>(maxjerk, -maxjerk, maxacc, -maxacc, velocity_, velmin_);
+		//
+		// Cruising slower than both the start and end velocities only uses up distance, so
+		// the search for the cruise velocity does not need to go below the higher of the two
+		//
+		double velmin = std::min(velocity_, std::max(velmin_, std::max(startvel, endvel)));
+		profile_ = std::make_shared<SCurveProfile>(maxjerk, -maxjerk, maxacc, -maxacc, velocity_, velmin);
 	}
 	else
 		profile_ = std::make_shared<TrapezoidalProfile>(maxacc, -maxacc, velocity_);
@@ -40,29 +46,3 @@ bool PathVelocitySegment::createProfile(bool scurve, double maxjerk, double maxa
 	assert(ret == false || std::fabs(profile_->getDistance(profile_->getTotalTime()) - length_) < 0.1);
 	return ret;
 }
-
-bool PathVelocitySegment::startsSame(const PathVelocitySegment& seg)
-{
-	return std::fabs(start() - seg.start()) < kEpsilon;
-}
-
-bool PathVelocitySegment::endsSame(const PathVelocitySegment& seg)
-{
-	return std::fabs(end() - seg.end()) < kEpsilon;
-}
-
-bool PathVelocitySegment::contains(const PathVelocitySegment& seg)
-{
-	return seg.start() >= start() && seg.end() <= seg.end();
-}
-
-bool PathVelocitySegment::overlaps(const PathVelocitySegment& seg)
-{
-	if (seg.start() >= start() && seg.start() <= end())
-		return true;
-
-	if (seg.end() >= start() && seg.end() <= end())
-		return true;
-
-	return false;
-}
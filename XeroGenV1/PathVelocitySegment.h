@@ -20,20 +20,11 @@ public:
 	double velocity() const { return velocity_; }
 	void setVelocity(double v) { velocity_ = v; }
 
-	bool startsSame(const PathVelocitySegment& seg);
-	bool endsSame(const PathVelocitySegment& seg);
-
-	bool overlaps(const PathVelocitySegment&);
-	bool contains(const PathVelocitySegment&);
-
 	bool createProfile(bool scurve, double maxjerk, double maxacc, double startvel, double endvel);
 
 	std::shared_ptr<xero::paths::SpeedProfileGenerator> profile() { return profile_; }
 	std::shared_ptr<const xero::paths::SpeedProfileGenerator> profile() const { return profile_; }
 
-private:
-	static constexpr double kEpsilon = 1e-5;
-
 private:
 	double start_dist_;
 	double length_;
@@ -1,9 +1,12 @@
 #include "JSONPathReader.h"
 #include "PathCollection.h"
+#include "PathBatch.h"
 #include "CSVWriter.h"
+#include "BinaryWriter.h"
 #include "PathTrajectory.h"
 #include "XeroGenV1PathGenerator.h"
 #include <iostream>
+#include <stdexcept>
 
 using namespace xero::paths;
 
@@ -14,6 +17,9 @@ static constexpr double kMaxDTheta = 0.1; //radians!
 std::string pathfile;
 std::string robotfile;
 std::string outfile;
+std::string outdir;
+size_t jobs = 0;
+bool binary = false;
 std::string units = "in";
 double timestep = 0.02;
 double diststep = 1.0;
@@ -23,10 +29,8 @@ double maxdx = kMaxDX;
 double maxdy = kMaxDY;
 double maxtheta = kMaxDTheta;
 double velmin = 10.0;
-double deltav = 5.0;
 
-extern void generateForGroup(const std::string& group);
-extern void generateForPath(PathGroup& group, const std::string& path);
+extern void generateForPath(PathBatch& batch, PathGroup& group, RobotPath& path);
 
 int main(int ac, char** av)
 {
@@ -201,9 +205,13 @@ int main(int ac, char** av)
 				return 1;
 			}
 
+			//
+			// Accepted so existing command lines still work, but the segment velocities are
+			// no longer lowered in steps to find a solution, so the value is only checked
+			//
 			arg = *av;
 			try {
-				deltav = std::stod(arg, &index);
+				(void)std::stod(arg, &index);
 			}
 			catch (...)
 			{
@@ -216,6 +224,7 @@ int main(int ac, char** av)
 				std::cerr << "XeroGenV1: expected floating point number following --delvel argument" << std::endl;
 				return 1;
 			}
+			std::cerr << "XeroGenV1: warning: --delvel is no longer used and is ignored" << std::endl;
 			ac--;
 			av++;
 		}
@@ -266,6 +275,45 @@ int main(int ac, char** av)
 			robotfile = *av++;
 			ac--;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
+		else if (arg == "--outdir")
+		{
+			if (ac == 0) {
+				std::cerr << "XeroGenV1: expected directory name following --outdir argument" << std::endl;
+				return 1;
+			}
+
+			outdir = *av++;
+			ac--;
+		}
+		else if (arg == "--jobs")
+		{
+			if (ac == 0) {
+				std::cerr << "XeroGenV1: expected integer number following --jobs argument" << std::endl;
+				return 1;
+			}
+
+			arg = *av;
+			try {
+				jobs = std::stoul(arg, &index);
+			}
+			catch (...)
+			{
+				std::cerr << "XeroGenV1: expected integer number following --jobs argument" << std::endl;
+				return 1;
+			}
+
+			if (index != arg.length() || jobs == 0)
+			{
+				std::cerr << "XeroGenV1: expected integer number following --jobs argument" << std::endl;
+				return 1;
+			}
+			ac--;
+			av++;
+		}
 		else if (arg == "--outfile")
 		{
 			if (ac == 0) {
@@ -308,40 +356,35 @@ int main(int ac, char** av)
 		return 1;
 	}
 
-	if (collection.getPathCount() != 1) {
-		std::cerr << "CheesyGen: can only process a single path in the paths file" << std::endl;
+	//
+	// A single path can go to the output file, any number of paths can go to an output
+	// directory, one file for each path
+	//
+	if (outdir.length() == 0 && collection.getPathCount() != 1) {
+		std::cerr << "XeroGenV1: can only process a single path in the paths file without --outdir" << std::endl;
 		return 1;
 	}
 
-	std::vector<std::string> groups = collection.getGroupNames();
-	for (const std::string& group : groups)
-		generateForGroup(group);
-}
+	if (jobs == 0)
+		jobs = PathBatch::defaultThreads();
 
-void generateForGroup(const std::string& group)
-{
-	auto gptr = collection.getGroupByName(group);
-	if (gptr == nullptr)
+	PathBatch batch(collection);
+	if (batch.run(jobs, [&batch](PathGroup& group, RobotPath& path) { generateForPath(batch, group, path); }) > 0)
 	{
-		std::cerr << "XeroGenV1: warning: path group '" << group << "' does not exist" << std::endl;
-		return;
+		for (const std::string& err : batch.errors())
+			std::cerr << "ERROR: " << err << std::endl;
+
+		return 99;
 	}
 
-	std::cout << "Generating paths for group " << group << " ... " << std::endl;
-	std::vector<std::string> paths = gptr->getPathNames();
-	for (const std::string& path : paths)
-		generateForPath(*gptr, path);
+	return 0;
 }
 
-void generateForPath(PathGroup& group, const std::string& path)
+void generateForPath(PathBatch& batch, PathGroup& group, RobotPath& path)
 {
-	std::cout << "  Generating paths for path " << path << " ... " << std::endl;
-	auto pptr = group.findPathByName(path);
-	if (pptr == nullptr)
 	{
-		std::cerr << "XeroGenV1: warning: path '" << path << "' does not exist in group '";
-		std::cerr << group.getName() << "'" << std::endl;
-		return;
+		std::lock_guard<std::mutex> guard(batch.consoleLock());
+		std::cout << "  Generating paths for path " << group.getName() << "/" << path.getName() << " ... " << std::endl;
 	}
 
 	//
@@ -351,16 +394,9 @@ void generateForPath(PathGroup& group, const std::string& path)
 	//
 	std::shared_ptr<PathTrajectory> trajectory;
 
-	XeroGenV1PathGenerator gen(diststep, timestep, scurve, maxdx, maxdy, maxtheta, deltav, velmin);
-	try {
-		trajectory = gen.generate(pptr->getPoints(), pptr->getConstraints(), pptr->getStartVelocity(),
-			pptr->getEndVelocity(), pptr->getMaxVelocity(), pptr->getMaxAccel(), pptr->getMaxJerk());
-	}
-	catch (const std::runtime_error& ex)
-	{
-		std::cerr << "ERROR: " << ex.what() << std::endl;
-		exit(99);
-	}
+	XeroGenV1PathGenerator gen(diststep, timestep, scurve, maxdx, maxdy, maxtheta, velmin);
+	trajectory = gen.generate(path.getPoints(), path.getConstraints(), path.getStartVelocity(),
+		path.getEndVelocity(), path.getMaxVelocity(), path.getMaxAccel(), path.getMaxJerk());
 
 	std::vector<std::string> headers =
 	{
@@ -374,11 +410,16 @@ void generateForPath(PathGroup& group, const std::string& path)
 		RobotPath::HeadingTag
 	};
 
-	std::ofstream strm(outfile);
+	std::string filename = outfile;
+	if (outdir.length() > 0)
+		filename = PathBatch::outputFile(outdir, group, path, binary ? ".bin" : ".csv");
+
+	std::ofstream strm(filename, binary ? std::ios::out | std::ios::binary : std::ios::out);
 	if (!strm.is_open())
-	{
-		std::cerr << "XeroGenV1: could not open file '" << outfile << "' for writing." << std::endl;
-		return;
-	}
-	CSVWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory->begin(), trajectory->end());
+		throw std::runtime_error("could not open file '" + filename + "' for writing");
+
+	if (binary)
+		BinaryWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory->begin(), trajectory->end());
+	else
+		CSVWriter::write<PathTrajectory::const_iterator>(strm, headers, trajectory->begin(), trajectory->end());
 }
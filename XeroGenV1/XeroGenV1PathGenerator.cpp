@@ -8,8 +8,10 @@
 #include <RobotPath.h>
 #include <DistanceView.h>
 #include <DistanceVelocityConstraint.h>
-#include <cassert>
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <stdexcept>
 #include <vector>
 
 using namespace xero::paths;
@@ -17,12 +19,19 @@ using namespace xero::paths;
 std::shared_ptr<xero::paths::PathTrajectory> 
 XeroGenV1PathGenerator::generate(const std::vector<Pose2d>& points, const ConstraintCollection &constraints,
 								 double startvel, double endvel, double maxvel, double maxaccel, double maxjerk) 
+{
+	std::shared_ptr<DistanceView> distview = prepare(points);
+	return generate(*distview, constraints, startvel, endvel, maxvel, maxaccel, maxjerk);
+}
+
+std::shared_ptr<DistanceView>
+XeroGenV1PathGenerator::prepare(const std::vector<Pose2d>& points)
 {
 	//
 	// Step 1: generate a set of splines that represent the path
 	//         (taken from the cheesy poofs code)
 	//
-	std::vector<std::shared_ptr<xero::paths::SplinePair>> splines = generateSplines(points);
+	std::vector<xero::paths::SplinePair> splines = generateSplines(points);
 
 	//
 	// Step 2: generate a set of points that represent the path where the curvature, x, and y do not 
@@ -34,8 +43,13 @@ XeroGenV1PathGenerator::generate(const std::vector<Pose2d>& points, const Constr
 	//
 	// Step 3: generate a set of points that are equi-distant apart (diststep_).
 	//
-	DistanceView distview(paramtraj, diststep_);
+	return std::make_shared<DistanceView>(paramtraj, diststep_);
+}
 
+std::shared_ptr<PathTrajectory>
+XeroGenV1PathGenerator::generate(const DistanceView& distview, const ConstraintCollection& constraints,
+								 double startvel, double endvel, double maxvel, double maxaccel, double maxjerk)
+{
 	//
 	// Step 4: apply the trajectory generation to the set of points
 	// 
@@ -47,190 +61,214 @@ XeroGenV1PathGenerator::generate(const std::vector<Pose2d>& points, const Constr
 	return std::make_shared<PathTrajectory>(TrajectoryName::Main, trajpts);
 }
 
-std::vector<std::shared_ptr<xero::paths::SplinePair>> 
+std::vector<xero::paths::SplinePair>
 XeroGenV1PathGenerator::generateSplines(const std::vector<xero::paths::Pose2d>& points)
 {
 	RobotPath path(nullptr, "");
 	for (const Pose2d& pt : points)
 		path.addPoint(pt);
 	path.generateSplines();
-	return path.getSplines();
+	return std::move(path.getSplines());
 }
 
-void XeroGenV1PathGenerator::getMinMaxVel(std::vector<PathVelocitySegment>& segs, size_t index, double& sv, double& ev, double startvel, double endvel)
+std::vector<Pose2dWithTrajectory> 
+XeroGenV1PathGenerator::generateTrajPoints(const DistanceView &distview, const ConstraintCollection& constraints, double startvel, double endvel,
+											double maxvel, double maxaccel, double maxjerk)
 {
-	if (index != 0)
-		sv = std::min(segs[index - 1].velocity(), segs[index].velocity());
-	else
-		sv = startvel;
-
-	if (index != segs.size() - 1)
-		ev = std::min(segs[index].velocity(), segs[index + 1].velocity());
-	else
-		ev = endvel;
+	//
+	// Break the path into segments, each with the velocity limit from the constraints that cover it
+	//
+	std::vector<PathVelocitySegment> segments = createSegments(distview.length(), constraints, maxvel);
+
+	//
+	// Find the velocities at the boundaries between segments that every segment can meet, then
+	// create the profile for each segment between its boundary velocities
+	//
+	std::vector<double> bounds = propagateVelocities(segments, startvel, endvel, maxaccel, maxjerk);
+
+	double total = 0.0;
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		if (!segments[i].createProfile(scurve_, maxjerk, maxaccel, bounds[i], bounds[i + 1]))
+			throw std::runtime_error("cannot find solution for scurve constraints");
+
+		total += segments[i].time();
+	}
+
+	return generatePoints(distview, segments, total);
 }
 
-bool XeroGenV1PathGenerator::adjustPrevious(std::vector<PathVelocitySegment>& segs, size_t index, double startvel, double endvel, double maxjerk, double maxaccel)
+std::vector<PathVelocitySegment> 
+XeroGenV1PathGenerator::createSegments(double length, const ConstraintCollection& constraints, double maxvel)
 {
-	if (index == 0)
-		return false;
+	std::vector<std::pair<double, double>> starts;
+	std::vector<std::pair<double, double>> ends;
+	std::vector<double> points;
 
-	double sv, ev;
-	double newprev = segs[index - 1].velocity() - deltav_;
+	points.push_back(0.0);
+	points.push_back(length);
 
-	while (newprev >= velmin_)
+	for (const auto& con : constraints)
 	{
-		//
-		// Reduce the end velocity of the previous segment
-		//
-		segs[index - 1].setVelocity(newprev);
+		auto distcon = std::dynamic_pointer_cast<DistanceVelocityConstraint>(con);
+		if (distcon == nullptr || distcon->getVelocity() == 0.0)
+			continue;
+
+		double after = std::max(distcon->getAfter(), 0.0);
+		double before = std::min(distcon->getBefore(), length);
+		if (before - after <= kEpsilon)
+			continue;
+
+		starts.push_back(std::make_pair(after, distcon->getVelocity()));
+		ends.push_back(std::make_pair(before, distcon->getVelocity()));
+		points.push_back(after);
+		points.push_back(before);
+	}
 
-		dumpSegments("Attempting", segs);
+	//
+	// The boundaries of the constraints, with any closer together than kEpsilon taken as the same
+	//
+	std::sort(points.begin(), points.end());
+	std::sort(starts.begin(), starts.end());
+	std::sort(ends.begin(), ends.end());
 
+	std::vector<double> bounds;
+	for (double pt : points)
+	{
+		if (bounds.size() == 0 || pt > bounds.back() + kEpsilon)
+			bounds.push_back(pt);
+	}
+
+	if (bounds.size() == 1)
+		bounds.push_back(length);
+
+	bounds.back() = length;
+
+	//
+	// Sweep along the path keeping the velocities of the constraints that cover the current
+	// interval.  The limit for the interval is the lowest of these and the maximum velocity.
+	//
+	std::vector<PathVelocitySegment> segs;
+	std::multiset<double> active;
+	size_t si = 0, ei = 0;
+
+	for (size_t i = 0; i < bounds.size() - 1; i++)
+	{
 		//
-		// Run and see if the new end velocity works.  It could fail if the end velocity causes
-		// the previous segment to not be achieivable because the gap from start velocity to 
-		// end velocity is too great
+		// Starts go in before ends come out, so a constraint that starts and ends within
+		// kEpsilon of the same boundary is removed again rather than left active
 		//
-		getMinMaxVel(segs, index - 1, sv, ev, startvel, endvel);
-		std::cout << "CreateProfile: index " << index - 1 << " start " << sv << " end " << ev << std::endl;
-		if (!segs[index - 1].createProfile(scurve_, maxjerk, maxaccel, sv, ev))
+		while (si < starts.size() && starts[si].first <= bounds[i] + kEpsilon)
 		{
-			//
-			// Recursively adjust the segment before the previous segment, all the way
-			// back to the beginning if necessary.
-			//
-			if (!adjustPrevious(segs, index - 1, startvel, endvel, maxjerk, maxaccel))
-				throw std::runtime_error("cannot find solution for scurve constraints");
+			active.insert(starts[si].second);
+			si++;
 		}
 
-		//
-		// Now run the current segment with the adjusted prev segment
-		//
-		getMinMaxVel(segs, index, sv, ev, startvel, endvel);
-		std::cout << "CreateProfile: index " << index << " start " << sv << " end " << ev << std::endl;
-		if (segs[index].createProfile(scurve_, maxjerk, maxaccel, sv, ev))
-			return true;
+		while (ei < ends.size() && ends[ei].first <= bounds[i] + kEpsilon)
+		{
+			auto it = active.find(ends[ei].second);
+			if (it != active.end())
+				active.erase(it);
+			ei++;
+		}
 
-		//
-		// Reduce the end velocity for the previous segment and try again
-		//
-		newprev -= velmin_;
+		double vel = maxvel;
+		if (active.size() > 0)
+			vel = std::min(vel, *active.begin());
+
+		if (segs.size() > 0 && segs.back().velocity() == vel)
+			segs.back().setEnd(bounds[i + 1]);
+		else
+			segs.push_back(PathVelocitySegment(bounds[i], bounds[i + 1] - bounds[i], vel, velmin_));
 	}
 
-	return false;
+	return segs;
 }
 
-void XeroGenV1PathGenerator::dumpSegments(const std::string &title, std::vector<PathVelocitySegment>& segs)
+std::vector<double> 
+XeroGenV1PathGenerator::propagateVelocities(const std::vector<PathVelocitySegment>& segs, double startvel, double endvel, double maxaccel, double maxjerk)
 {
-	std::cout << "===========================================" << std::endl;
-	std::cout << title << std::endl;
-	std::cout << "===========================================" << std::endl;
-	for (size_t i = 0; i < segs.size(); i++)
-	{
-		const PathVelocitySegment& seg = segs[i];
-		std::cout << i << ":";
-		std::cout << " start " << seg.start();
-		std::cout << " end " << seg.end();
-		std::cout << " velocity " << seg.velocity(); 
-		std::cout << std::endl;
-	}
-	std::cout << "===========================================" << std::endl;
-}
+	std::vector<double> bounds(segs.size() + 1);
 
-std::vector<Pose2dWithTrajectory> 
-XeroGenV1PathGenerator::generateTrajPoints(const DistanceView &distview, const ConstraintCollection& constraints, double startvel, double endvel,
-											double maxvel, double maxaccel, double maxjerk)
-{
-	std::vector<PathVelocitySegment> segments;
+	bounds.front() = startvel;
+	bounds.back() = endvel;
+	for (size_t i = 1; i < segs.size(); i++)
+		bounds[i] = std::min(segs[i - 1].velocity(), segs[i].velocity());
 
 	//
-	// Create the first segment, which is start to finish with max velocity.  Constraints will
-	// be added to break this segment up into smaller pieces
+	// Forward, the velocity at the end of each segment cannot be more than can be reached
+	// by accelerating through the segment
 	//
-	PathVelocitySegment s(0.0, distview.length(), maxvel);
-	segments.push_back(s);
+	for (size_t i = 0; i < segs.size(); i++)
+	{
+		double reach = reachableVelocity(bounds[i], segs[i].length(), maxaccel, maxjerk);
+		if (i == segs.size() - 1 && reach < endvel - kEpsilon)
+			throw std::runtime_error("the path is not long enough to reach the end velocity");
 
-	dumpSegments("Before constraints", segments);
+		bounds[i + 1] = std::min(bounds[i + 1], reach);
+	}
 
 	//
-	// Add the constraints, this breaks the segments into smaller pieces to consider the constraints
+	// Backward, the velocity at the start of each segment cannot be more than can be slowed
+	// from in time for the end of the segment
 	//
-	for(const auto &con: constraints)
-	{ 
-		auto distcon = std::dynamic_pointer_cast<DistanceVelocityConstraint>(con);
-		if (distcon != nullptr)
-		{
-			if (distcon->getVelocity() == 0.0)
-				continue;
-
-			if (distcon->getAfter() >= distcon->getBefore())
-				continue;
+	for (size_t i = segs.size(); i-- > 0; )
+	{
+		double reach = reachableVelocity(bounds[i + 1], segs[i].length(), maxaccel, maxjerk);
+		if (i == 0 && reach < startvel - kEpsilon)
+			throw std::runtime_error("the path is not long enough to slow from the start velocity");
 
-			PathVelocitySegment newseg(distcon->getAfter(), distcon->getBefore() - distcon->getAfter(), distcon->getVelocity());
-			insertSegment(segments, newseg);
-		}
+		bounds[i] = std::min(bounds[i], reach);
 	}
 
-	dumpSegments("After Constraints", segments);
-	bool looping = true;
-	double total = 0;
+	bounds.front() = startvel;
+	bounds.back() = endvel;
+	return bounds;
+}
 
-	while (looping)
+double XeroGenV1PathGenerator::reachableVelocity(double vel, double dist, double maxaccel, double maxjerk) const
+{
+	dist *= 1.0 - kReachMargin;
+	if (dist <= 0.0)
+		return vel;
+
+	if (!scurve_)
+		return std::sqrt(vel * vel + 2.0 * maxaccel * dist);
+
+	//
+	// The distance covered while the acceleration ramps up to the limit and straight back down
+	//
+	double tramp = maxaccel / maxjerk;
+	double dlimit = (2.0 * vel + maxaccel * tramp) * tramp;
+
+	if (dist <= dlimit)
 	{
-		looping = false;
 		//
-		// Create the profile
+		// The acceleration does not reach the limit.  Ramping up and down for a time s each covers
+		// (2 * vel + maxjerk * s^2) * s, solved for s by Cardano's formula in a form that does not
+		// lose precision when vel is large.
 		//
-		total = 0.0;
-		for (size_t i = 0; i < segments.size(); i++)
-		{
-			double sv, ev;
-
-			if (i == 0)
-				sv = startvel;
-			else
-				sv = std::min(segments[i - 1].velocity(), segments[i].velocity());
-
-			if (i == segments.size() - 1)
-				ev = endvel;
-			else
-				ev = std::min(segments[i].velocity(), segments[i + 1].velocity());
-
-			if (!segments[i].createProfile(scurve_, maxjerk, maxaccel, sv, ev))
-			{
-#ifdef TRY_RECURSION
-				//
-				// We cannot create this profile, we are over constrained.  This generally means the end 
-				// of the last segment velocity is high enough that we cannot get down to the start velocity
-				// of this segment.  See if we can lower the end velocity of the last segment.
-				//
-				if (!adjustPrevious(segments, i, startvel, endvel, maxjerk, maxaccel))
-					throw std::runtime_error("cannot find solution for scurve constraints");
-#else
-				throw std::runtime_error("cannot find solution for scurve constraints");
-#endif
-				looping = true;
-			}
-			total += segments[i].time();
-		}
+		double p = 2.0 * vel / maxjerk;
+		double q = dist / maxjerk;
+		double u = std::cbrt(q / 2.0 + std::sqrt(q * q / 4.0 + p * p * p / 27.0));
+		double s = u - p / (3.0 * u);
+		return vel + maxjerk * s * s;
 	}
-	dumpSegments("Complete", segments);
 
-	for (size_t i = 0; i < segments.size(); i++)
-	{
-		std::cout << "Segment " << i << ":";
-		std::cout << " start velocity " << segments[i].profile()->getStartVelocity();
-		std::cout << " end velocity " << segments[i].profile()->getEndVelocity();
-		std::cout << std::endl;
-	}
-
-	return generatePoints(distview, segments, total);
+	//
+	// The acceleration holds at the limit, a change of dv takes dv / maxaccel + tramp and
+	// covers the average of the two velocities over that time
+	//
+	double a = 1.0 / (2.0 * maxaccel);
+	double b = vel / maxaccel + tramp / 2.0;
+	double c = vel * tramp - dist;
+	return vel + (-b + std::sqrt(b * b - 4.0 * a * c)) / (2.0 * a);
 }
 
 std::vector<Pose2dWithTrajectory> XeroGenV1PathGenerator::generatePoints(const DistanceView& distview, const std::vector<PathVelocitySegment>& segments, double total)
 {
 	std::vector<Pose2dWithTrajectory> result;
+	DistanceView::Cursor cursor = distview.cursor();
 	size_t sindex = 0;
 	double tstart = 0.0;
 	double dstart = 0.0;
@@ -238,6 +276,7 @@ std::vector<Pose2dWithTrajectory> XeroGenV1PathGenerator::generatePoints(const D
 	size_t iter = 0;
 	bool looping = true;
 
+	result.reserve(static_cast<size_t>(total / timestep_) + 2);
 	while (looping)
 	{
 		double t = iter * timestep_;
@@ -250,10 +289,10 @@ std::vector<Pose2dWithTrajectory> XeroGenV1PathGenerator::generatePoints(const D
 			t = total;
 		}
 
-		if (t - tstart > profile->getTotalTime() && sindex < segments.size() - 1)
+		while (t - tstart > profile->getTotalTime() && sindex < segments.size() - 1)
 		{
 			//
-			// We are transistioning between profiles
+			// We are transistioning between profiles, possibly past segments shorter than a timestep
 			//
 			tstart += segments[sindex].profile()->getTotalTime();
 			dstart += segments[sindex].profile()->getTotalDistance();
@@ -266,7 +305,7 @@ std::vector<Pose2dWithTrajectory> XeroGenV1PathGenerator::generatePoints(const D
 		double acc = profile->getAccel(t - tstart);
 		double jerk = (acc - prevacc) / timestep_;
 
-		Pose2d pt = distview[dst];
+		Pose2d pt = cursor[dst];
 		Pose2dWithTrajectory trajpt(pt, reportt, dst, vel, acc, jerk);
 		result.push_back(trajpt);
 
@@ -276,79 +315,3 @@ std::vector<Pose2dWithTrajectory> XeroGenV1PathGenerator::generatePoints(const D
 
 	return result;
 }
-
-void XeroGenV1PathGenerator::insertSegment(std::vector<PathVelocitySegment>& segs, PathVelocitySegment &newseg)
-{
-	for (size_t i = 0; i < segs.size(); i++)
-	{
-		PathVelocitySegment& cur = segs[i];
-		if (cur.overlaps(newseg))
-		{
-			if (cur.contains(newseg))
-			{
-				if (newseg.velocity() > cur.velocity())
-					return;
-
-				if (cur.startsSame(newseg) && cur.endsSame(newseg))
-				{
-					//
-					// This segment is identical to the one in the list already, but with
-					// a lower velocity, just set the lower velocity
-					//
-					cur.setVelocity(newseg.velocity());
-					return;
-				}
-				else if (cur.startsSame(newseg))
-				{
-					auto it = segs.begin();
-					std::advance(it, i);
-					cur.setStart(newseg.end());
-					cur.setLength(cur.length() - newseg.length());
-					segs.insert(it, newseg);
-					return;
-				}
-				else if (cur.endsSame(newseg))
-				{
-					auto it = segs.begin();
-					std::advance(it, i + 1);
-					cur.setEnd(newseg.start());
-					segs.insert(it, newseg);
-					return;
-				}
-				else
-				{
-					double end = cur.end();
-					double vel = cur.velocity();
-					cur.setEnd(newseg.start());
-					auto it = segs.begin();
-					std::advance(it, i + 1);
-					bool isend = (it == segs.end());
-
-					segs.insert(it, newseg);
-					PathVelocitySegment addseg(newseg.end(), end - newseg.end(), vel);
-					if (isend)
-						segs.push_back(addseg);
-					else
-					{
-						it = segs.begin();
-						std::advance(it, i + 2);
-						segs.insert(it, addseg);
-					}
-					return;
-				}
-			}
-			else
-			{
-				//
-				// New segment overlaps the end of the cur segment
-				//
-				PathVelocitySegment aseg(newseg.start(), cur.end(), newseg.velocity());
-				PathVelocitySegment bseg(cur.end(), newseg.end(), newseg.velocity());
-				insertSegment(segs, aseg);
-				insertSegment(segs, bseg);
-				return;
-			}
-		}
-	}
-	assert(false);
-}
@@ -13,14 +13,13 @@
 class XeroGenV1PathGenerator
 {
 public:
-	XeroGenV1PathGenerator(double diststep, double timestep, bool scurve, double maxdx, double maxdy, double maxtheta, double deltav, double velmin) {
+	XeroGenV1PathGenerator(double diststep, double timestep, bool scurve, double maxdx, double maxdy, double maxtheta, double velmin) {
 		diststep_ = diststep;
 		timestep_ = timestep;
 		maxDx_ = maxdx;
 		maxDy_ = maxdy;
 		maxDTheta_ = maxtheta;
 		scurve_ = scurve;
-		deltav_ = deltav;
 		velmin_ = velmin;
 	}
 
@@ -29,28 +28,59 @@ public:
 														  double startvel, double endvel, double maxvel, 
 														  double maxaccel, double maxjerk);
 
+	//
+	// The steps of generate() that depend only on the waypoints, and the steps that depend on
+	// the velocity limits.  A caller generating the same path with different velocity limits
+	// can call prepare() once and then generate() with the distance view for each set of limits.
+	//
+	std::shared_ptr<xero::paths::DistanceView> prepare(const std::vector<xero::paths::Pose2d>& points);
+	std::shared_ptr<xero::paths::PathTrajectory> generate(const xero::paths::DistanceView& distview,
+														  const xero::paths::ConstraintCollection& constraints,
+														  double startvel, double endvel, double maxvel,
+														  double maxaccel, double maxjerk);
+
 private:
-	std::vector<std::shared_ptr<xero::paths::SplinePair>> generateSplines(const std::vector<xero::paths::Pose2d>& points);
+	std::vector<xero::paths::SplinePair> generateSplines(const std::vector<xero::paths::Pose2d>& points);
 
 	std::vector<xero::paths::Pose2dWithTrajectory> generateTrajPoints(const xero::paths::DistanceView &distview, 
 			const xero::paths::ConstraintCollection& constraints, double startvel, double endvel, double maxvel, double maxaccel, double maxjerk);
 
-	void insertSegment(std::vector<PathVelocitySegment>& segs, PathVelocitySegment &newseg);
-	bool adjustPrevious(std::vector<PathVelocitySegment> &segs, size_t i, double startvel, double endvel, double maxjerk, double maxaccel);
-	void getMinMaxVel(std::vector<PathVelocitySegment>& segs, size_t i, double& sv, double& ev, double startvel, double endvel);
+	//
+	// Split the path into segments with a single velocity limit each, the lowest of the
+	// maximum velocity and the distance constraints covering that part of the path
+	//
+	std::vector<PathVelocitySegment> createSegments(double length, const xero::paths::ConstraintCollection& constraints, double maxvel);
+
+	//
+	// Find the velocity at each boundary between segments, by a pass forward limiting each
+	// boundary to what can be reached by accelerating from the one before it, and a pass
+	// backward limiting each boundary to what can be slowed from in time for the one after it
+	//
+	std::vector<double> propagateVelocities(const std::vector<PathVelocitySegment>& segs, double startvel, double endvel, double maxaccel, double maxjerk);
 
-	void dumpSegments(const std::string &title, std::vector<PathVelocitySegment>& segs);
+	//
+	// The highest velocity that can be reached from the velocity given over the distance
+	// given, starting and ending with no acceleration for an s-curve
+	//
+	double reachableVelocity(double vel, double dist, double maxaccel, double maxjerk) const;
 
 	std::vector<xero::paths::Pose2dWithTrajectory> generatePoints(const xero::paths::DistanceView& distview, const std::vector<PathVelocitySegment>& segments, double total);
 
 private:
+	static constexpr double kEpsilon = 1e-5;
+
+	//
+	// The fraction of a segment held back when finding the velocity that can be reached in
+	// it, so the profile for the segment is not failed by rounding
+	//
+	static constexpr double kReachMargin = 1e-9;
+
 	double diststep_;
 	double timestep_;
 	double maxDx_;
 	double maxDy_;
 	double maxDTheta_;
 	bool scurve_;
-	double deltav_;
 	double velmin_;
 };
 
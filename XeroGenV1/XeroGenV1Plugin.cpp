@@ -0,0 +1,99 @@
+#include "XeroGenV1PathGenerator.h"
+#include <GeneratorPlugin.h>
+
+using namespace xero::paths;
+
+//
+// A path prepared once, and generated for each set of velocity limits
+//
+class XeroGenV1Session : public GeneratorSession
+{
+public:
+	XeroGenV1Session(const XeroGenV1PathGenerator &gen, const RobotPath& path) : gen_(gen) {
+		distview_ = gen_.prepare(path.getPoints());
+		constraints_ = path.getConstraints();
+		startvel_ = path.getStartVelocity();
+		endvel_ = path.getEndVelocity();
+		maxjerk_ = path.getMaxJerk();
+	}
+
+	virtual ~XeroGenV1Session() {
+	}
+
+	virtual std::shared_ptr<PathTrajectory> generate(double maxvel, double maxaccel) {
+		return gen_.generate(*distview_, constraints_, startvel_, endvel_, maxvel, maxaccel, maxjerk_);
+	}
+
+private:
+	XeroGenV1PathGenerator gen_;
+	std::shared_ptr<DistanceView> distview_;
+	ConstraintCollection constraints_;
+	double startvel_;
+	double endvel_;
+	double maxjerk_;
+};
+
+//
+// In process version of the XeroGenV1 program.  The defaults and the arguments
+// match the command line arguments processed in XeroGenV1.cpp.
+//
+class XeroGenV1Plugin : public GeneratorPlugin
+{
+public:
+	XeroGenV1Plugin() {
+	}
+
+	virtual ~XeroGenV1Plugin() {
+	}
+
+	virtual std::shared_ptr<PathTrajectory> generate(const RobotParams& robot, const RobotPath& path,
+		double maxvel, double maxaccel, const std::vector<std::string>& args)
+	{
+		return createSession(robot, path, args)->generate(maxvel, maxaccel);
+	}
+
+	virtual std::shared_ptr<GeneratorSession> createSession(const RobotParams& robot, const RobotPath& path,
+		const std::vector<std::string>& args)
+	{
+		double timestep = robot.getTimestep();
+		double diststep = 1.0;
+		double maxdx = kMaxDX;
+		double maxdy = kMaxDY;
+		double maxtheta = kMaxDTheta;
+		double velmin = 10.0;
+		bool scurve = true;
+		std::string str;
+
+		getDoubleArg(args, "--timestep", timestep);
+		getDoubleArg(args, "--diststep", diststep);
+		getDoubleArg(args, "--maxdx", maxdx);
+		getDoubleArg(args, "--maxdy", maxdy);
+		getDoubleArg(args, "--maxtheta", maxtheta);
+		getDoubleArg(args, "--minvel", velmin);
+
+		//
+		// --delvel may still be given by existing generator files.  The segment velocities are
+		// no longer lowered in steps, so it is not looked up and has no effect.
+		//
+
+		if (getStringArg(args, "--scurve", str))
+		{
+			if (str == "true")
+				scurve = true;
+			else if (str == "false")
+				scurve = false;
+			else
+				throw std::runtime_error("expected 'true' or 'false' following --scurve argument");
+		}
+
+		XeroGenV1PathGenerator gen(diststep, timestep, scurve, maxdx, maxdy, maxtheta, velmin);
+		return std::make_shared<XeroGenV1Session>(gen, path);
+	}
+
+private:
+	static constexpr double kMaxDX = 2.0; //inches
+	static constexpr double kMaxDY = 0.05; //inches
+	static constexpr double kMaxDTheta = 0.1; //radians!
+};
+
+XERO_GENERATOR_PLUGIN(XeroGenV1Plugin)
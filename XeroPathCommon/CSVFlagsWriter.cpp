@@ -1,5 +1,6 @@
 #include "CSVFlagsWriter.h"
 #include <TrajectoryNames.h>
+#include <OutputBuffer.h>
 #include <fstream>
 
 using namespace xero::paths;
@@ -11,6 +12,9 @@ bool CSVFlagsWriter::writeFlags(std::shared_ptr<xero::paths::RobotPath> path, co
 	if (!outstrm.is_open())
 		return false;
 
+	OutputBuffer& out = OutputBuffer::local();
+	out.clear();
+
 	for (auto flag : path->getFlags())
 	{
 		double btime, atime;
@@ -31,9 +35,9 @@ bool CSVFlagsWriter::writeFlags(std::shared_ptr<xero::paths::RobotPath> path, co
 		if (!traj->getTimeForDistance(flag->after(), atime))
 			continue;
 
-		outstrm << '"' << flag->name() << '"' << ",";
-		outstrm << atime << "," << btime << std::endl;
+		out << '"' << flag->name() << '"' << ',';
+		out << atime << ',' << btime << '\n';
 	}
 
-	return true;
+	return out.write(outstrm);
 }
\ No newline at end of file
@@ -15,9 +15,11 @@
 //
 #pragma once
 #include "GeneratorParameter.h"
+#include <GeneratorPlugin.h>
 #include <QVersionNumber>
 #include <string>
 #include <list>
+#include <memory>
 
 
 class Generator
@@ -103,6 +105,26 @@ public:
 		return dir_ + "/" + exec_;
 	}
 
+	void setPluginName(const std::string& name) {
+		plugin_name_ = name;
+	}
+
+	const std::string& getPluginName() const {
+		return plugin_name_;
+	}
+
+	void setPlugin(std::shared_ptr<xero::paths::GeneratorPlugin> plugin) {
+		plugin_ = plugin;
+	}
+
+	std::shared_ptr<xero::paths::GeneratorPlugin> getPlugin() const {
+		return plugin_;
+	}
+
+	bool hasPlugin() const {
+		return plugin_ != nullptr;
+	}
+
 	static constexpr const char* DistanceContraintPropertyName = "distance_constraint";
 	static constexpr const char* NonZeroStartEndVelocities = "nonzero_start_end_velocity";
 
@@ -119,4 +141,6 @@ private:
 	std::string other_args_;
 	std::list<GeneratorParameter> params_;
 	std::list<std::string> properties_;
+	std::string plugin_name_;
+	std::shared_ptr<xero::paths::GeneratorPlugin> plugin_;
 };
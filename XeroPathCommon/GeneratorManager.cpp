@@ -19,6 +19,7 @@
 #include <QJsonObject>
 #include <QDebug>
 #include <QCoreApplication>
+#include <QLibrary>
 #include <QVersionNumber>
 #include <algorithm>
 
@@ -213,7 +214,7 @@ bool GeneratorManager::processJSONFile(QFile& file)
 
 bool GeneratorManager::processProgram(QFile &file, QJsonObject& obj, const std::string &name, const QVersionNumber &genver)
 {
-	std::string exec, out, robot, path, timestep, units, otherargs;
+	std::string exec, plugin, out, robot, path, timestep, units, otherargs;
 
 	QFileInfo info(file);
 	QDir dir = info.dir();
@@ -242,7 +243,18 @@ bool GeneratorManager::processProgram(QFile &file, QJsonObject& obj, const std::
 			return false;
 	}
 
+	if (obj.contains(pluginTag))
+	{
+		if (!getJSONStringValue(file, obj, pluginTag, plugin))
+			return false;
+	}
+
 	std::shared_ptr<Generator> gen = std::make_shared<Generator>(name, genver, dir.path().toStdString(), exec, units, out, robot, path, timestep, otherargs);
+	if (plugin.length() > 0)
+	{
+		gen->setPluginName(plugin);
+		loadPlugin(dir, gen);
+	}
 
 	//
 	// Now process parameters
@@ -283,6 +295,39 @@ bool GeneratorManager::processProgram(QFile &file, QJsonObject& obj, const std::
 	return true;
 }
 
+void GeneratorManager::loadPlugin(QDir& dir, std::shared_ptr<Generator> gen)
+{
+	//
+	// The plugin is optional.  If it cannot be loaded, the generator program is run instead
+	// for each path, so failures here are not errors.
+	//
+	QLibrary lib(dir.absoluteFilePath(gen->getPluginName().c_str()));
+	if (!lib.load())
+	{
+		qDebug() << "generator '" << gen->getName().c_str() << "': cannot load plugin, using program - " << lib.errorString();
+		return;
+	}
+
+	xero::paths::GeneratorPluginEntry entry = reinterpret_cast<xero::paths::GeneratorPluginEntry>(lib.resolve(xero::paths::GeneratorPlugin::EntryPointName));
+	if (entry == nullptr)
+	{
+		qDebug() << "generator '" << gen->getName().c_str() << "': plugin does not contain entry point '" << xero::paths::GeneratorPlugin::EntryPointName << "', using program";
+		return;
+	}
+
+	xero::paths::GeneratorPlugin* plugin = (*entry)(xero::paths::GeneratorPlugin::InterfaceVersion);
+	if (plugin == nullptr)
+	{
+		qDebug() << "generator '" << gen->getName().c_str() << "': plugin interface version mismatch, using program";
+		return;
+	}
+
+	//
+	// The library is never unloaded, the plugin lives as long as the generator
+	//
+	gen->setPlugin(std::shared_ptr<xero::paths::GeneratorPlugin>(plugin));
+}
+
 bool GeneratorManager::processParameter(QFile& file, QJsonObject& obj, std::shared_ptr<Generator> gen)
 {
 	std::string name, desc, type, arg;
@@ -61,6 +61,7 @@ private:
 	static constexpr const char* programTag = "program";
 	static constexpr const char* propertiesTag = "properties";
 	static constexpr const char* execTag = "exec";
+	static constexpr const char* pluginTag = "plugin";
 	static constexpr const char* unitsTag = "units";
 	static constexpr const char* otherArgsTag = "others";
 	static constexpr const char* outputTag = "output";
@@ -85,6 +86,7 @@ private:
 	virtual bool processJSONFile(QFile& file);
 	bool processProgram(QFile& file, QJsonObject& obj, const std::string& name, const QVersionNumber &genver);
 	bool processParameter(QFile& file, QJsonObject& obj, std::shared_ptr<Generator> gen);
+	void loadPlugin(QDir& dir, std::shared_ptr<Generator> gen);
 
 	void readGenerators(QDir& dir, std::list<std::shared_ptr<Generator>>& generators);
 
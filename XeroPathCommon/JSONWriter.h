@@ -15,18 +15,27 @@
 //
 #pragma once
 
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
+#include <PathTrajectory.h>
+#include <JSONEmitter.h>
+#include <OutputBuffer.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <list>
+#include <map>
 #include <string>
 
 namespace xero
 {
 	namespace paths
 	{
+		//
+		// Writes a trajectory as JSON with the version, the path properties and the points.
+		// The document is streamed to the output as it is produced, in the layout and key
+		// order the Qt JSON writer gave it, so the memory used does not depend on the
+		// length of the trajectory.
+		//
 		class JSONWriter
 		{
 		public:
@@ -36,39 +45,106 @@ namespace xero
 			template<class InputIt>
 			static bool write(std::ostream &strm, std::vector<std::string>& headers, InputIt first, InputIt last, const std::list<std::pair<std::string, std::string>>& props)
 			{
-				QJsonArray trajectory;
-				QJsonObject pt;
-				QJsonObject top;
-				QJsonObject propobj;
+				JSONEmitter json(strm, OutputBuffer::local());
+				std::vector<size_t> fields = sortedFields(headers);
 
-				top["_version"] = "1";
-				for (const std::pair<std::string, std::string>& entry : props)
-				{
-					propobj[QString::fromStdString(entry.first)] = QString::fromStdString(entry.second);
-				}
-				top["properities"] = propobj;
+				beginDocument(json);
 				for (auto it = first; it != last; it++)
 				{
-					pt = QJsonObject();
 					const ICsv& cl = *it;
-					for (size_t i = 0; i < headers.size(); i++)
+
+					json.beginObject();
+					for (size_t i : fields)
 					{
-						double v = cl.getField(headers[i]);
-						pt[headers[i].c_str()] = v;
+						json.key(headers[i]);
+						json.value(cl.getField(headers[i]));
 					}
-					trajectory.append(pt);
+					json.endObject();
+				}
+
+				return endDocument(json, props);
+			}
+
+		private:
+			//
+			// The order the fields of a point are written in.  Qt keeps the members of
+			// an object sorted by name, with one entry for each name.
+			//
+			static std::vector<size_t> sortedFields(const std::vector<std::string>& headers)
+			{
+				std::vector<size_t> fields;
+
+				for (size_t i = 0; i < headers.size(); i++)
+					fields.push_back(i);
+
+				std::stable_sort(fields.begin(), fields.end(), [&headers](size_t a, size_t b) { return headers[a] < headers[b]; });
+				fields.erase(std::unique(fields.begin(), fields.end(), [&headers](size_t a, size_t b) { return headers[a] == headers[b]; }), fields.end());
+
+				return fields;
+			}
+
+			static void beginDocument(JSONEmitter& json)
+			{
+				json.beginObject();
+				json.key("_version");
+				json.value(std::string("1"));
+				json.key("points");
+				json.beginArray();
+			}
+
+			static bool endDocument(JSONEmitter& json, const std::list<std::pair<std::string, std::string>>& props)
+			{
+				std::map<std::string, std::string> sorted;
+
+				for (const std::pair<std::string, std::string>& entry : props)
+					sorted[entry.first] = entry.second;
+
+				json.endArray();
+				json.key("properities");
+				json.beginObject();
+				for (const std::pair<const std::string, std::string>& entry : sorted)
+				{
+					json.key(entry.first);
+					json.value(entry.second);
 				}
-				top["points"] = trajectory;
-				QJsonDocument doc;
-				doc.setObject(top);
-				strm << doc.toJson().toStdString();
+				json.endObject();
+				json.endObject();
 
-				return true;
+				return json.finish();
 			}
 		};
-	}
-}
 
+		//
+		// Look up the column for each header once, then write the points straight from
+		// the trajectory columns
+		//
+		template<>
+		inline bool JSONWriter::write<PathTrajectory::const_iterator>(std::ostream& strm, std::vector<std::string>& headers,
+			PathTrajectory::const_iterator first, PathTrajectory::const_iterator last, const std::list<std::pair<std::string, std::string>>& props)
+		{
+			JSONEmitter json(strm, OutputBuffer::local());
+			std::vector<size_t> fields = sortedFields(headers);
 
+			beginDocument(json);
 
+			if (first != last)
+			{
+				std::vector<const std::vector<double>*> columns = first.trajectory()->columns(headers);
+				double nan = std::nan("");
 
+				for (size_t row = first.index(); row < last.index(); row++)
+				{
+					json.beginObject();
+					for (size_t i : fields)
+					{
+						json.key(headers[i]);
+						json.value(columns[i] != nullptr ? (*columns[i])[row] : nan);
+					}
+					json.endObject();
+				}
+			}
+
+			return endDocument(json, props);
+		}
+	}
+}
@@ -16,7 +16,8 @@
 #include "PathGenerationEngine.h"
 #include "PathCollectionIO.h"
 #include "RobotManager.h"
-#include "CSVParser.h"
+#include <CSVTrajectoryReader.h>
+#include <BinaryTrajectoryReader.h>
 #include <DistanceVelocityConstraint.h>
 #include <TankDriveModifier.h>
 #include <SwerveDriveModifier.h>
@@ -25,13 +26,17 @@
 #include <QProcess>
 #include <QTemporaryFile>
 #include <cassert>
+#include <stdexcept>
 #include <algorithm>
+#include <iterator>
 
 using namespace xero::paths;
 
 PathGenerationEngine::PathGenerationEngine()
 {
 	parallel_ = 2;
+	busy_ = 0;
+	speed_tolerance_ = 0.05;
 	init();
 }
 
@@ -43,6 +48,23 @@ void PathGenerationEngine::markPathDirty(std::shared_ptr<RobotPath> path)
 {
 	waiting_paths_lock_.lock();
 
+	//
+	// Any results generated from the path as it was before this call are stale
+	//
+	epochs_[path]++;
+
+	complete_paths_locks.lock();
+	status_.erase(path);
+	complete_paths_locks.unlock();
+
+	per_thread_data_lock_.lock();
+	for (thread_data* data : per_thread_data_)
+	{
+		if (data->path_ == path)
+			data->cancel_ = true;
+	}
+	per_thread_data_lock_.unlock();
+
 	auto it = std::find(waiting_.begin(), waiting_.end(), path);
 	if (it != waiting_.end())
 	{
@@ -63,6 +85,7 @@ void PathGenerationEngine::markPathDirty(std::shared_ptr<RobotPath> path)
 #endif
 
 	waiting_paths_lock_.unlock();
+	work_cv_.notify_one();
 	cleanup();
 }
 
@@ -74,6 +97,13 @@ void PathGenerationEngine::init()
 	for (size_t i = 0; i < parallel_; i++)
 	{
 		thread_data* data = new thread_data();
+		data->running_ = true;
+		data->stopped_ = false;
+		data->idle_ = true;
+		data->epoch_ = 0;
+		data->cancel_ = false;
+		data->ok_ = false;
+		data->cached_ = false;
 		per_thread_data_.push_back(data);
 		data->thread_ = new std::thread([this, data] { this->threadFunction(data); });
 	}
@@ -81,23 +111,21 @@ void PathGenerationEngine::init()
 
 void PathGenerationEngine::stopAll()
 {
-	std::chrono::milliseconds delay(100);
-
+	//
+	// Clear the running flag while holding the waiting paths lock so a thread
+	// cannot miss the wakeup between checking for work and going to sleep
+	//
+	waiting_paths_lock_.lock();
+	per_thread_data_lock_.lock();
 	for (size_t i = 0; i < per_thread_data_.size(); i++)
 		per_thread_data_[i]->running_ = false;
+	per_thread_data_lock_.unlock();
+	waiting_paths_lock_.unlock();
 
-	while (true)
-	{
-		per_thread_data_lock_.lock();
-		if (per_thread_data_.size() == 0)
-		{
-			per_thread_data_lock_.unlock();
-			break;
-		}
+	work_cv_.notify_all();
 
-		per_thread_data_lock_.unlock();
-		std::this_thread::sleep_for(delay);
-	}
+	std::unique_lock<std::mutex> lock(per_thread_data_lock_);
+	threads_cv_.wait(lock, [this] { return per_thread_data_.size() == 0; });
 }
 
 void PathGenerationEngine::cleanup()
@@ -132,57 +160,269 @@ std::shared_ptr<RobotPath> PathGenerationEngine::getComplete()
 	return path;
 }
 
-void PathGenerationEngine::waitForAllIdle()
+bool PathGenerationEngine::getStatus(std::shared_ptr<RobotPath> path, PathStatus& status)
 {
-	auto delay = std::chrono::milliseconds(100);
-	bool busy = true;
+	std::lock_guard<std::mutex> guard(complete_paths_locks);
+
+	auto it = status_.find(path);
+	if (it == status_.end())
+		return false;
+
+	status = it->second;
+	return true;
+}
 
-	while (busy)
+bool PathGenerationEngine::waitForComplete(std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> lock(waiting_paths_lock_);
+	return idle_cv_.wait_for(lock, timeout, [this] { return waiting_.size() == 0 && busy_ == 0; });
+}
+
+void PathGenerationEngine::waitForComplete()
+{
+	std::unique_lock<std::mutex> lock(waiting_paths_lock_);
+	idle_cv_.wait(lock, [this] { return waiting_.size() == 0 && busy_ == 0; });
+}
+
+void PathGenerationEngine::waitForAllIdle(std::unique_lock<std::mutex> &lock)
+{
+	idle_cv_.wait(lock, [this] { return busy_ == 0; });
+}
+
+bool PathGenerationEngine::isRunning(std::shared_ptr<RobotPath> path)
+{
+	std::lock_guard<std::mutex> guard(per_thread_data_lock_);
+
+	for (thread_data* data : per_thread_data_)
 	{
-		busy = false;
-		for (auto data : per_thread_data_)
-		{
-			if (data->idle_ == false)
-			{
-				busy = true;
-				break;
-			}
-		}
-		std::this_thread::sleep_for(delay);
+		if (data->path_ == path)
+			return true;
 	}
+
+	return false;
+}
+
+std::list<std::shared_ptr<RobotPath>>::iterator PathGenerationEngine::findWork()
+{
+	//
+	// A path that is still being generated by another thread is skipped until
+	// that thread is done, so results for a path are always produced in order
+	//
+	for (auto it = waiting_.begin(); it != waiting_.end(); it++)
+	{
+		if (!isRunning(*it))
+			return it;
+	}
+
+	return waiting_.end();
 }
 
 std::shared_ptr<RobotPath> PathGenerationEngine::waitForWork(thread_data *data)
 {
 	std::shared_ptr<RobotPath> path;
-	std::chrono::milliseconds delay(100);
+	std::unique_lock<std::mutex> lock(waiting_paths_lock_);
 
 	data->idle_ = true;
+	work_cv_.wait(lock, [this, data] {
+		return !data->running_ || (robot_ != nullptr && generator_ != nullptr && findWork() != waiting_.end());
+	});
 
-	while (data->running_)
+	if (!data->running_)
+		return nullptr;
+
+	auto it = findWork();
+	path = *it;
+	waiting_.erase(it);
+	busy_++;
+
+	per_thread_data_lock_.lock();
+	data->path_ = path;
+	data->epoch_ = epochs_[path];
+	data->cancel_ = false;
+	data->idle_ = false;
+	data->start_ = std::chrono::steady_clock::now();
+	data->ok_ = false;
+	data->cached_ = false;
+	per_thread_data_lock_.unlock();
+
+	return path;
+}
+
+void PathGenerationEngine::pathComplete(thread_data* data)
+{
+	CompleteCallback cb;
+	std::shared_ptr<RobotPath> path = data->path_;
+	bool current = false;
+	PathStatus status;
+
+	status.ok_ = data->ok_;
+	status.cached_ = data->cached_;
+	status.elapsed_ = std::chrono::steady_clock::now() - data->start_;
+
+	waiting_paths_lock_.lock();
+	auto it = epochs_.find(path);
+	if (it != epochs_.end() && it->second == data->epoch_ && !data->cancel_)
+	{
+		//
+		// Nothing changed while the path was generated, so these are the newest results
+		//
+		epochs_.erase(it);
+		current = true;
+	}
+
+	per_thread_data_lock_.lock();
+	data->path_ = nullptr;
+	per_thread_data_lock_.unlock();
+
+	busy_--;
+	waiting_paths_lock_.unlock();
+
+	//
+	// Another thread may be waiting for this path to be done before it starts it again
+	//
+	work_cv_.notify_all();
+	idle_cv_.notify_all();
+
+	if (!current)
+	{
+#ifdef _DEBUG
+		qDebug() << "'" << path->getName().c_str() << "' results superseded, not published";
+#endif
+		return;
+	}
+
+	complete_paths_locks.lock();
+	complete_.push_back(path);
+	status_[path] = status;
+	cb = complete_callback_;
+	complete_paths_locks.unlock();
+
+	if (cb)
+		cb(path);
+}
+
+void PathGenerationEngine::getGeneratorArgs(QStringList& args)
+{
+	QString str = generator_->getTimestepArg().c_str();
+	str.replace("$$", std::to_string(robot_->getTimestep()).c_str());
+	QStringList onearg = str.split(' ');
+	args.append(onearg);
+
+	if (generator_->hasOtherArgs())
+	{
+		str = generator_->getOtherArgs().c_str();
+		onearg = str.split(' ');
+		args.append(onearg);
+	}
+
+	store_lock_.lock();
+	for (const GeneratorParameter& p : generator_->getGeneratorParams())
 	{
-		if (robot_ == nullptr || generator_ == nullptr)
+		if (store_.hasParameterValue(p.getName().c_str()))
 		{
-			std::this_thread::sleep_for(delay);
-			continue;
+			str = p.getArg().c_str();
+			QVariant v = store_[p.getName().c_str()];
+			if (p.getType() == GeneratorParameter::DoublePropType)
+			{
+				str.replace("$$", std::to_string(v.toDouble()).c_str());
+				onearg = str.split(' ');
+				args.append(onearg);
+			}
+			else if (p.getType() == GeneratorParameter::IntegerPropType)
+			{
+				str.replace("$$", std::to_string(v.toInt()).c_str());
+				onearg = str.split(' ');
+				args.append(onearg);
+			}
+			else if (p.getType() == GeneratorParameter::StringPropType)
+			{
+				str.replace("$$", v.toString());
+				onearg = str.split(' ');
+				args.append(onearg);
+			}
+			else if (p.getType() == GeneratorParameter::StringListPropType)
+			{
+				str.replace("$$", v.toString());
+				onearg = str.split(' ');
+				args.append(onearg);
+			}
+			else
+			{
+				qWarning() << "unhandled generator parameter type '" << p.getType().c_str() << "' in generator JSON file";
+			}
 		}
+	}
+	store_lock_.unlock();
+}
 
-		waiting_paths_lock_.lock();
-		if (waiting_.size() == 0)
+void PathGenerationEngine::getPluginArgs(std::vector<std::string>& args)
+{
+	QStringList qargs;
+
+	getGeneratorArgs(qargs);
+	for (const QString& arg : qargs)
+	{
+		if (arg.length() > 0)
+			args.push_back(arg.toStdString());
+	}
+}
+
+bool PathGenerationEngine::createSession(std::shared_ptr<xero::paths::RobotPath> path, std::shared_ptr<GeneratorSession>& session)
+{
+	std::vector<std::string> args;
+
+	getPluginArgs(args);
+
+	try {
+		session = generator_->getPlugin()->createSession(*robot_, *path, args);
+	}
+	catch (const std::runtime_error& ex)
+	{
+		qDebug() << "Generator failed, path '" << path->getName().c_str() << "' - " << ex.what();
+		path->addError(true, "cannot generate trajectory for this path");
+		return false;
+	}
+
+	return true;
+}
+
+bool PathGenerationEngine::runPlugin(std::shared_ptr<xero::paths::RobotPath> path, std::shared_ptr<GeneratorSession> session, 
+	double maxvel, double maxaccel, std::shared_ptr<PathTrajectory>& traj)
+{
+	std::vector<std::string> args;
+
+#ifdef _DEBUG
+	qDebug() << "==================================================";
+	qDebug() << "Running path'" << path->getName().c_str() << "' in process";
+#endif
+
+	try {
+		if (session != nullptr)
 		{
-			waiting_paths_lock_.unlock();
-			std::this_thread::sleep_for(delay);
-			continue;
+			traj = session->generate(maxvel, maxaccel);
+		}
+		else
+		{
+			getPluginArgs(args);
+			traj = generator_->getPlugin()->generate(*robot_, *path, maxvel, maxaccel, args);
 		}
-
-		path = waiting_.front();
-		waiting_.pop_front();
-		waiting_paths_lock_.unlock();
-		break;
+	}
+	catch (const std::runtime_error& ex)
+	{
+		qDebug() << "Generator failed, path '" << path->getName().c_str() << "' - " << ex.what();
+		path->addError(true, "cannot generate trajectory for this path");
+		return false;
 	}
 
-	data->idle_ = false;
-	return path;
+	if (traj == nullptr)
+		return false;
+
+	if (traj->name() != TrajectoryName::Main)
+		traj = std::make_shared<PathTrajectory>(TrajectoryName::Main, *traj);
+
+	qDebug() << "Generator finished sucessfully, path '" << path->getName().c_str() << "'";
+
+	return true;
 }
 
 bool PathGenerationEngine::runGenerator(std::shared_ptr<xero::paths::RobotPath> path, double maxvel, double maxaccel, thread_data *data, QTemporaryFile &outfile)
@@ -215,6 +455,7 @@ bool PathGenerationEngine::runGenerator(std::shared_ptr<xero::paths::RobotPath>
 		waiting_paths_lock_.lock();
 		waiting_.push_back(path);
 		waiting_paths_lock_.unlock();
+		work_cv_.notify_one();
 		return false;
 	}
 	path->setMaxVelocity(savevel);
@@ -228,6 +469,7 @@ bool PathGenerationEngine::runGenerator(std::shared_ptr<xero::paths::RobotPath>
 		waiting_paths_lock_.lock();
 		waiting_.push_back(path);
 		waiting_paths_lock_.unlock();
+		work_cv_.notify_one();
 		return false;
 	}
 
@@ -247,56 +489,7 @@ bool PathGenerationEngine::runGenerator(std::shared_ptr<xero::paths::RobotPath>
 	onearg = str.split(' ');
 	args.append(onearg);
 
-	str = generator_->getTimestepArg().c_str();
-	str.replace("$$", std::to_string(robot_->getTimestep()).c_str());
-	onearg = str.split(' ');
-	args.append(onearg);
-
-	if (generator_->hasOtherArgs())
-	{
-		str = generator_->getOtherArgs().c_str();
-		onearg = str.split(' ');
-		args.append(onearg);
-	}
-
-	store_lock_.lock();
-	for (const GeneratorParameter& p : generator_->getGeneratorParams())
-	{
-		if (store_.hasParameterValue(p.getName().c_str()))
-		{
-			str = p.getArg().c_str();
-			QVariant v = store_[p.getName().c_str()];
-			if (p.getType() == GeneratorParameter::DoublePropType)
-			{
-				str.replace("$$", std::to_string(v.toDouble()).c_str());
-				onearg = str.split(' ');
-				args.append(onearg);
-			}
-			else if (p.getType() == GeneratorParameter::IntegerPropType)
-			{
-				str.replace("$$", std::to_string(v.toInt()).c_str());
-				onearg = str.split(' ');
-				args.append(onearg);
-			}
-			else if (p.getType() == GeneratorParameter::StringPropType)
-			{
-				str.replace("$$", v.toString());
-				onearg = str.split(' ');
-				args.append(onearg);
-			}
-			else if (p.getType() == GeneratorParameter::StringListPropType)
-			{
-				str.replace("$$", v.toString());
-				onearg = str.split(' ');
-				args.append(onearg);
-			}
-			else
-			{
-				qWarning() << "unhandled generator parameter type '" << p.getType().c_str() << "' in generator JSON file";
-			}
-		}
-	}
-	store_lock_.unlock();
+	getGeneratorArgs(args);
 
 #ifdef _DEBUG
 	QString robottempfilename("C:/cygwin64/home/butch/robottools/test/robot.json");
@@ -331,16 +524,16 @@ bool PathGenerationEngine::runGenerator(std::shared_ptr<xero::paths::RobotPath>
 	QByteArray ret;
 	QString readdata;
 	std::string error, output;
-	int count = 120;			// Two minutes
+	int count = 1200;			// Two minutes
 
 #ifdef _DEBUG
 	qDebug() << "Waiting for generator to finish";
 #endif
-	while (!p->waitForFinished(1000) && count > 0)
+	while (!p->waitForFinished(100) && count > 0 && !shouldStop(data))
 	{
 		count--;
 #ifdef _DEBUG
-		if ((count % 10) == 0)
+		if ((count % 100) == 0)
 			qDebug() << "    still waiting, count = " << count;
 #endif
 	}
@@ -354,7 +547,7 @@ bool PathGenerationEngine::runGenerator(std::shared_ptr<xero::paths::RobotPath>
 	readdata = QString(ret);
 	output += readdata.toStdString();
 
-	if (!data->running_ || count == 0)
+	if (shouldStop(data) || count == 0)
 	{
 		qDebug() << "killed generator, path '" << path->getName().c_str() << "'";
 		qDebug() << "#########################################################";
@@ -389,175 +582,267 @@ bool PathGenerationEngine::runGenerator(std::shared_ptr<xero::paths::RobotPath>
 	return true;
 }
 
-bool PathGenerationEngine::readResults(QFile& outfile, std::vector<Pose2dWithTrajectory>& pts)
+bool PathGenerationEngine::readResults(QFile& outfile, std::shared_ptr<PathTrajectory>& traj)
 {
-	CSVParser parser;
+	std::string filename = outfile.fileName().toStdString();
+	bool ok;
+
+	//
+	// The generators that ship with the tools write the binary format, anything else
+	// is expected to write CSV
+	//
+	traj = std::make_shared<PathTrajectory>(TrajectoryName::Main);
+	if (BinaryTrajectoryReader::isBinary(filename))
+		ok = BinaryTrajectoryReader::read(filename, *traj);
+	else
+		ok = CSVTrajectoryReader::read(filename, *traj);
 
-	if (!parser.open(outfile.fileName().toStdString()))
+	if (!ok)
+	{
+		qDebug() << "cannot read generator output file '" << outfile.fileName() << "'";
+		traj = nullptr;
 		return false;
+	}
 
-	while (parser.hasData())
-	{
-		double time = parser.getData(RobotPath::TimeTag);
-		double x = parser.getData(RobotPath::XTag);
-		double y = parser.getData(RobotPath::YTag);
-		double heading = parser.getData(RobotPath::HeadingTag);
-		double pos = parser.getData(RobotPath::PositionTag);
-		double velocity = parser.getData(RobotPath::VelocityTag);
-		double accel = parser.getData(RobotPath::AccelerationTag);
-		double jerk = parser.getData(RobotPath::JerkTag);
-
-		Translation2d trans(x, y);
-		Rotation2d rot = Rotation2d::fromDegrees(heading);
-		Pose2d pose(trans, rot);
-		Pose2dWithTrajectory tpt;
-
-		double cur = 0.0, swrot = 0.0;
-		
-		if (parser.hasDataField(RobotPath::CurvatureTag))
-		{
-			cur = parser.getData(RobotPath::CurvatureTag);
-		}
+	return true;
+}
 
-		if (parser.hasDataField(RobotPath::RotationTag))
-		{
-			swrot = parser.getData(RobotPath::RotationTag);
-		}
+bool PathGenerationEngine::generatePass(std::shared_ptr<xero::paths::RobotPath> path, thread_data* data, std::shared_ptr<GeneratorSession> session,
+	double percent, std::shared_ptr<PathTrajectory>& traj)
+{
+	double vel = path->getMaxVelocity() * (1 - percent);
+	double acc = path->getMaxAccel() * (1 - percent);
 
-		tpt = Pose2dWithTrajectory(pose, time, pos, velocity, accel, jerk, cur, swrot);
+	traj = nullptr;
 
-		pts.push_back(tpt);
+	if (shouldStop(data))
+	{
+		//
+		// The path changed or the engine is stopping, the results are not needed
+		//
+		return false;
+	}
+
+#ifdef _DEBUG
+	qDebug() << "processing path '" << path->getName().c_str() << "', speed reduction " << percent;
+#endif
 
-		if (!parser.next())
-			return false;
+	if (generator_->hasPlugin())
+	{
+		//
+		// The generator is loaded into this process, no files or programs needed
+		//
+		return runPlugin(path, session, vel, acc, traj);
 	}
 
-	parser.close();
-	return true;
+	QTemporaryFile outfile;
+	outfile.setAutoRemove(true);
+	outfile.open();
+	outfile.close();
+
+	if (!runGenerator(path, vel, acc, data, outfile))
+	{
+		//
+		// Generation failed, no results to process
+		//
+		return false;
+	}
+
+	//
+	// Now parse the data the results
+	//
+	return readResults(outfile, traj);
+}
+
+bool PathGenerationEngine::applyPass(std::shared_ptr<xero::paths::RobotPath> path, thread_data* data, DriveModifier* mod,
+	double percent, std::shared_ptr<PathTrajectory> traj)
+{
+	//
+	// Do not replace the trajectories of a path with results for an older version of the path
+	//
+	if (shouldStop(data))
+		return false;
+
+	path->addTrajectory(traj);
+
+	SwerveDriveModifier* sw = dynamic_cast<SwerveDriveModifier*>(mod);
+	if (sw != nullptr)
+		sw->setRotationalPercent(percent);
+
+	return mod->modify(*robot_, path, units_);
+}
+
+QByteArray PathGenerationEngine::cacheKey(std::shared_ptr<xero::paths::RobotPath> path)
+{
+	std::lock_guard<std::mutex> guard(store_lock_);
+	return TrajectoryCache::key(*robot_, *path, *generator_, store_, units_, speed_tolerance_);
 }
 
 bool PathGenerationEngine::runOnePath(std::shared_ptr<xero::paths::RobotPath> path, thread_data* data)
 {
-	QTemporaryFile* outfile = nullptr;
+	std::shared_ptr<GeneratorSession> session;
+	std::shared_ptr<PathTrajectory> traj, best;
 	double percent = 0.0;
-	std::vector<Pose2dWithTrajectory> pts;
+	bool ret = false;
 	DriveModifier* mod = nullptr;
 	bool swerve = false;
-	QString filename;
+	std::shared_ptr<TrajectoryCache> cache = cache_;
+	size_t nprops = path->props().size();
+	QByteArray key;
 
+	path->clearErrors();
+
+	//
+	// A path generated before with the same robot, generator and parameters does not
+	// need to be generated again
+	//
+	if (cache != nullptr)
+	{
+		key = cacheKey(path);
+		if (!shouldStop(data) && cache->load(key, *path))
+		{
 #ifdef _DEBUG
-	int pass = 1;
+			qDebug() << "'" << path->getName().c_str() << "' read from the trajectory cache";
 #endif
+			data->cached_ = true;
+			return true;
+		}
+	}
 
 	if (robot_->getDriveType() == RobotParams::DriveType::TankDrive)
 	{
 		mod = new TankDriveModifier();
-		percent = 0.0;
 		swerve = false;
 	}
 	else if (robot_->getDriveType() == RobotParams::DriveType::SwerveDrive)
 	{
 		mod = new SwerveDriveModifier();
-		percent = 0.0;
 		swerve = true;
 	}
 
-	while (true)
+	//
+	// If the generator supports it, the splines for the path are computed once and
+	// reused for each speed reduction tried below
+	//
+	if (generator_->hasPlugin() && !createSession(path, session))
 	{
-		pts.clear();
-
-		try {
-			outfile = new QTemporaryFile();
-			filename = outfile->fileName();
-			outfile->setAutoRemove(true);
-			outfile->open();
-			outfile->close();
-			filename = outfile->fileName();
-		}
-		catch (...) {
-			qDebug() << "exception in temporary file";
-		}
-
-#ifdef _DEBUG
-		qDebug() << "processing path '" << path->getName().c_str() << "', pass " << pass;
-#endif
+		delete mod;
+		return false;
+	}
 
-		double vel = path->getMaxVelocity();
-		double acc = path->getMaxAccel();
-		if (!runGenerator(path, vel * (1 - percent), acc * (1 - percent), data, *outfile))
-		{
-			//
-			// Generation failed, no results to process
-			//
-			delete outfile;
-			return false;
-		}
+	if (!generatePass(path, data, session, percent, traj))
+	{
+		delete mod;
+		return false;
+	}
 
+	if (applyPass(path, data, mod, percent, traj))
+	{
+		ret = true;
+	}
+	else if (!shouldStop(data))
+	{
 		//
-		// Now parse the data the results
+		// The drive base cannot follow the path at full speed.  Find the smallest reduction
+		// in speed that works by bisection, starting with the largest reduction allowed.
 		//
-		if (!readResults(*outfile, pts))
-		{
-			delete outfile;
-			return false;
-		}
+		double lo = 0.0;
+		double hi = kMaxSpeedReduction;
+		double tolerance = getSpeedReductionTolerance();
+		bool applied = false;
 
-		auto traj = std::make_shared<PathTrajectory>(TrajectoryName::Main, pts);
-		path->addTrajectory(traj);
-
-		if (swerve)
+		if (generatePass(path, data, session, hi, traj))
 		{
-			SwerveDriveModifier* sw = dynamic_cast<SwerveDriveModifier*>(mod);
-			assert(sw != nullptr);
-			sw->setRotationalPercent(percent);
+			if (applyPass(path, data, mod, hi, traj))
+			{
+				best.swap(traj);
+				applied = true;
+				ret = true;
+			}
+			else if (!shouldStop(data))
+			{
+				qDebug() << "path '" << path->getName().c_str() << "' does not meet the drive base limits at any speed";
+				path->addError(true, "cannot generate trajectory for this path");
+			}
 		}
 
-		if (mod->modify(*robot_, path, units_))
+		while (ret && hi - lo > tolerance)
 		{
-			//
-			// Now, add the delays and rotational stuff to the path
-			//
-			if (swerve)
+			double mid = (lo + hi) / 2.0;
+			if (!generatePass(path, data, session, mid, traj))
 			{
-				SwerveDriveModifier* sw = dynamic_cast<SwerveDriveModifier*>(mod);
-				assert(sw != nullptr);
-
-				double rvel = sw->GroundToRotational(*robot_, vel * percent);
-				double racc = sw->GroundToRotational(*robot_, acc * percent);
-
-				path->addProp("rvel", QString::number(rvel).toStdString());
-				path->addProp("racc", QString::number(racc).toStdString());
-				path->addProp("startdelay", QString::number(path->getStartAngleDelay()).toStdString());
-				path->addProp("enddelay", QString::number(path->getEndAngleDelay()).toStdString());
+				//
+				// The search cannot go on, but the best trajectory found so far still works.  It
+				// is put back below, and the error from the failed pass does not apply to it.
+				//
+				path->clearErrors();
+				break;
 			}
 
-			delete outfile;
-			break;
+			if (applyPass(path, data, mod, mid, traj))
+			{
+				hi = mid;
+				best.swap(traj);
+				applied = true;
+			}
+			else
+			{
+				lo = mid;
+				applied = false;
+			}
 		}
 
-		percent += 0.05;
-		delete outfile;
+		//
+		// If the last pass tried did not work, put back the best one that did
+		//
+		if (ret && !applied && !applyPass(path, data, mod, hi, best))
+			ret = false;
+
+		percent = hi;
+	}
+
+	if (ret && swerve)
+	{
+		//
+		// Now, add the delays and rotational stuff to the path
+		//
+		SwerveDriveModifier* sw = dynamic_cast<SwerveDriveModifier*>(mod);
+		assert(sw != nullptr);
+
+		double vel = path->getMaxVelocity();
+		double acc = path->getMaxAccel();
+		double rvel = sw->GroundToRotational(*robot_, vel * percent);
+		double racc = sw->GroundToRotational(*robot_, acc * percent);
+
+		path->addProp("rvel", QString::number(rvel).toStdString());
+		path->addProp("racc", QString::number(racc).toStdString());
+		path->addProp("startdelay", QString::number(path->getStartAngleDelay()).toStdString());
+		path->addProp("enddelay", QString::number(path->getEndAngleDelay()).toStdString());
+	}
+
+	if (ret && cache != nullptr && !shouldStop(data))
+	{
+		//
+		// Only the props added while generating belong with these trajectories
+		//
+		auto first = std::next(path->props().begin(), static_cast<std::ptrdiff_t>(nprops));
+		cache->save(key, *path, TrajectoryCache::PropList(first, path->props().end()));
 	}
 
 	delete mod;
-	return true;
+	return ret;
 }
 
 void PathGenerationEngine::threadFunction(thread_data* data)
 {
-	data->running_ = true;
-	data->stopped_ = false;
-
 	while (data->running_)
 	{
 		std::shared_ptr<RobotPath> path = waitForWork(data);
 		if (path == nullptr)
 			continue;
 
-		runOnePath(path, data);
-		complete_paths_locks.lock();
-		complete_.push_back(path);
-		complete_paths_locks.unlock();
+		data->ok_ = runOnePath(path, data);
+		pathComplete(data);
 	}
 
 	per_thread_data_lock_.lock();
@@ -565,5 +850,7 @@ void PathGenerationEngine::threadFunction(thread_data* data)
 	assert(it != per_thread_data_.end());
 	per_thread_data_.erase(it);
 	old_thread_data_.push_back(data);
+	data->stopped_ = true;
 	per_thread_data_lock_.unlock();
+	threads_cv_.notify_all();
 }
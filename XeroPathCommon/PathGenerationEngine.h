@@ -17,10 +17,17 @@
 
 #include "GeneratorParameterStore.h"
 #include "Generator.h"
+#include "TrajectoryCache.h"
 #include <RobotParams.h>
 #include <RobotPath.h>
+#include <DriveModifier.h>
 #include <QTemporaryFile>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -31,16 +38,42 @@ public:
 	PathGenerationEngine();
 	virtual ~PathGenerationEngine();
 
+	typedef std::function<void(std::shared_ptr<xero::paths::RobotPath>)> CompleteCallback;
+
+	//
+	// How the generation of a path that was placed on the complete list went
+	//
+	struct PathStatus
+	{
+		bool ok_;
+		bool cached_;
+		std::chrono::duration<double> elapsed_;
+	};
+
+	//
+	// The number of paths that are not yet complete, either waiting to be
+	// generated or being generated by a thread now
+	//
 	size_t waitingPaths() {
 		size_t ret;
 
 		waiting_paths_lock_.lock();
-		ret = waiting_.size();
+		ret = waiting_.size() + busy_;
 		waiting_paths_lock_.unlock();
 
 		return ret;
 	}
 
+	//
+	// The callback is called from the generation thread each time a path is placed on the
+	// complete list.  It must not block, it is expected to schedule work on another thread.
+	//
+	void setCompleteCallback(CompleteCallback cb) {
+		complete_paths_locks.lock();
+		complete_callback_ = cb;
+		complete_paths_locks.unlock();
+	}
+
 	GeneratorParameterStore& getParameterStore() {
 		return store_;
 	}
@@ -54,23 +87,25 @@ public:
 	void setRobot(std::shared_ptr<xero::paths::RobotParams> robot) {
 		stopAll();
 		cleanup();
-		waiting_paths_lock_.lock();
+		std::unique_lock<std::mutex> lock(waiting_paths_lock_);
 		waiting_.clear();
-		waitForAllIdle();
+		waitForAllIdle(lock);
+		epochs_.clear();
+		clearStatus();
 		robot_ = robot;
 		init();
-		waiting_paths_lock_.unlock();
 	}
 
 	void setGenerator(std::shared_ptr<Generator> gen) {
 		stopAll();
 		cleanup();
-		waiting_paths_lock_.lock();
+		std::unique_lock<std::mutex> lock(waiting_paths_lock_);
 		waiting_.clear();
-		waitForAllIdle();
+		waitForAllIdle(lock);
+		epochs_.clear();
+		clearStatus();
 		generator_ = gen;
 		init();
-		waiting_paths_lock_.unlock();
 	}
 
 	void setParallel(size_t count) {
@@ -85,40 +120,136 @@ public:
 		units_ = v;
 	}
 
+	//
+	// Paths found in the cache are read from it rather than generated, and paths that are
+	// generated are added to it.  Set to nullptr to always generate paths.
+	//
+	void setCache(std::shared_ptr<TrajectoryCache> cache) {
+		cache_ = cache;
+	}
+
+	std::shared_ptr<TrajectoryCache> getCache() const {
+		return cache_;
+	}
+
+	//
+	// When the drive base cannot follow a path at full speed, the speed is reduced until it
+	// can.  The reduction is found by bisection and this is the precision of the search.
+	//
+	// A tolerance smaller than kMinSpeedReductionTolerance, including one that is not positive
+	// and would never end the search, is raised to it.
+	//
+	void setSpeedReductionTolerance(double v) {
+		speed_tolerance_ = (v >= kMinSpeedReductionTolerance) ? v : kMinSpeedReductionTolerance;
+	}
+
+	double getSpeedReductionTolerance() const {
+		return speed_tolerance_;
+	}
+
 	void markPathDirty(std::shared_ptr<xero::paths::RobotPath> path);
 	void stopAll();
 	std::shared_ptr<xero::paths::RobotPath> getComplete();
 
+	//
+	// The status of the last generation of a path that was placed on the complete list.
+	// Returns false if the path has not been completed.
+	//
+	bool getStatus(std::shared_ptr<xero::paths::RobotPath> path, PathStatus& status);
+
+	//
+	// Wait until every path marked dirty has been generated, or until the timeout
+	// expires.  Returns true if all paths are complete.
+	//
+	bool waitForComplete(std::chrono::milliseconds timeout);
+	void waitForComplete();
+
 private:
+	//
+	// The largest reduction in speed tried before giving up on a path
+	//
+	static constexpr double kMaxSpeedReduction = 0.95;
+
+	//
+	// The finest precision allowed for the search for the speed reduction
+	//
+	static constexpr double kMinSpeedReductionTolerance = 0.001;
+
 	struct thread_data
 	{
 		std::thread* thread_;
 		bool running_;
 		bool stopped_;
 		bool idle_;
+
+		//
+		// The path being generated and the epoch of the path when it was taken
+		// from the waiting list.  cancel_ is set if the path is marked dirty again
+		// while it is being generated, since the results would be stale.
+		//
+		std::shared_ptr<xero::paths::RobotPath> path_;
+		uint64_t epoch_;
+		std::atomic<bool> cancel_;
+
+		//
+		// When the path was taken from the waiting list and how it went
+		//
+		std::chrono::steady_clock::time_point start_;
+		bool ok_;
+		bool cached_;
 	};
 
 private:
 	void init();
 	void cleanup();
 	void threadFunction(thread_data *arg);
-	void waitForAllIdle();
+	void waitForAllIdle(std::unique_lock<std::mutex> &lock);
+	void pathComplete(thread_data* data);
+	bool isRunning(std::shared_ptr<xero::paths::RobotPath> path);
+	std::list<std::shared_ptr<xero::paths::RobotPath>>::iterator findWork();
+	bool shouldStop(thread_data* data) {
+		return !data->running_ || data->cancel_;
+	}
+
+	void clearStatus() {
+		std::lock_guard<std::mutex> guard(complete_paths_locks);
+		status_.clear();
+	}
 
+	void getGeneratorArgs(QStringList& args);
+	void getPluginArgs(std::vector<std::string>& args);
 	bool runGenerator(std::shared_ptr<xero::paths::RobotPath> path, double maxvel, double maxaccel, thread_data* data, QTemporaryFile &outfile);
+	bool createSession(std::shared_ptr<xero::paths::RobotPath> path, std::shared_ptr<xero::paths::GeneratorSession>& session);
+	bool runPlugin(std::shared_ptr<xero::paths::RobotPath> path, std::shared_ptr<xero::paths::GeneratorSession> session,
+		double maxvel, double maxaccel, std::shared_ptr<xero::paths::PathTrajectory>& traj);
+	bool generatePass(std::shared_ptr<xero::paths::RobotPath> path, thread_data* data, std::shared_ptr<xero::paths::GeneratorSession> session,
+		double percent, std::shared_ptr<xero::paths::PathTrajectory>& traj);
+	bool applyPass(std::shared_ptr<xero::paths::RobotPath> path, thread_data* data, xero::paths::DriveModifier* mod,
+		double percent, std::shared_ptr<xero::paths::PathTrajectory> traj);
 	bool runOnePath(std::shared_ptr<xero::paths::RobotPath> path, thread_data* data);
-	bool readResults(QFile& outfile, std::vector<xero::paths::Pose2dWithTrajectory>& pts);
+	QByteArray cacheKey(std::shared_ptr<xero::paths::RobotPath> path);
+	bool readResults(QFile& outfile, std::shared_ptr<xero::paths::PathTrajectory>& traj);
 	std::shared_ptr<xero::paths::RobotPath> waitForWork(thread_data *data);
 
 private:
 	std::list<std::shared_ptr<xero::paths::RobotPath>> waiting_;
 	std::list<std::shared_ptr<xero::paths::RobotPath>> complete_;
+	std::map<std::shared_ptr<xero::paths::RobotPath>, uint64_t> epochs_;
+	std::map<std::shared_ptr<xero::paths::RobotPath>, PathStatus> status_;
 	std::shared_ptr<xero::paths::RobotParams> robot_;
 	std::shared_ptr<Generator> generator_;
+	std::shared_ptr<TrajectoryCache> cache_;
 	std::mutex waiting_paths_lock_;
 	std::mutex per_thread_data_lock_;
 	std::mutex complete_paths_locks;
 	std::mutex store_lock_;
+	std::condition_variable work_cv_;
+	std::condition_variable idle_cv_;
+	std::condition_variable threads_cv_;
+	CompleteCallback complete_callback_;
+	size_t busy_;
 	size_t parallel_;
+	double speed_tolerance_;
 	std::vector<thread_data*> per_thread_data_;
 	std::list<thread_data*> old_thread_data_;
 	GeneratorParameterStore store_;
@@ -2,9 +2,9 @@
 
 #include "MathUtils.h"
 #include "ICsv.h"
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
+#include <PathTrajectory.h>
+#include <OutputBuffer.h>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -12,6 +12,11 @@ namespace xero
 {
 	namespace paths
 	{
+		//
+		// Writes the JSON layout read by the WPILib PathWeaver trajectory classes.  The text is
+		// the same as the Qt JSON writer produced, with the keys in sorted order, numbers in
+		// their shortest round trip form, and null for values that are not finite.
+		//
 		class PathWeaverWriter
 		{
 		public:
@@ -21,42 +26,101 @@ namespace xero
 			template<class InputIt>
 			static bool write(std::ostream & strm, std::vector<std::string> & headers, InputIt first, InputIt last)
 			{
-				QJsonArray trajectory;
-				QJsonObject pt, pose, trans, rot;
-				QJsonObject top;
+				(void)headers;
 
+				OutputBuffer& out = OutputBuffer::local();
+				bool firstpt = true;
+
+				out.clear();
+				out << "[\n";
 				for (auto it = first; it != last; it++)
 				{
-					pt = QJsonObject();
 					const ICsv& cl = *it;
 
-					pt["time"] = cl.getField("time");
-					pt["velocity"] = cl.getField("velocity");
-					pt["acceleration"] = cl.getField("acceleration");
-					pt["curvature"] = cl.getField("curvature");
+					writePoint(out, firstpt, cl.getField("time"), cl.getField("velocity"), cl.getField("acceleration"), cl.getField("curvature"),
+						cl.getField("x"), cl.getField("y"), xero::paths::MathUtils::degreesToRadians(cl.getField("heading")));
+					firstpt = false;
+				}
+				out << (firstpt ? "]\n" : "\n]\n");
 
-					pose = QJsonObject();
+				return out.write(strm);
+			}
 
-					trans = QJsonObject();
-					trans["x"] = cl.getField("x");
-					trans["y"] = cl.getField("y");
-					pose["translation"] = trans;
+		private:
+			static void writeNumber(OutputBuffer& out, double v)
+			{
+				if (std::isfinite(v))
+					out.appendNumber(v, NumberFormat::Shortest, 0);
+				else
+					out << "null";
+			}
 
-					rot = QJsonObject();
-					rot["radians"] = xero::paths::MathUtils::degreesToRadians(cl.getField("heading"));
-					pose["rotation"] = rot;
+			static void writePoint(OutputBuffer& out, bool firstpt, double time, double velocity, double acceleration, double curvature,
+				double x, double y, double radians)
+			{
+				if (!firstpt)
+					out << ",\n";
 
-					pt["pose"] = pose;
-					trajectory.append(pt);
-				}
+				out << "    {\n";
+				out << "        \"acceleration\": ";
+				writeNumber(out, acceleration);
+				out << ",\n        \"curvature\": ";
+				writeNumber(out, curvature);
+				out << ",\n        \"pose\": {\n";
+				out << "            \"rotation\": {\n";
+				out << "                \"radians\": ";
+				writeNumber(out, radians);
+				out << "\n            },\n";
+				out << "            \"translation\": {\n";
+				out << "                \"x\": ";
+				writeNumber(out, x);
+				out << ",\n                \"y\": ";
+				writeNumber(out, y);
+				out << "\n            }\n";
+				out << "        },\n";
+				out << "        \"time\": ";
+				writeNumber(out, time);
+				out << ",\n        \"velocity\": ";
+				writeNumber(out, velocity);
+				out << "\n    }";
+			}
+		};
 
-				QJsonDocument doc;
-				doc.setArray(trajectory);
-				strm << doc.toJson().toStdString();
+		//
+		// Read the fields PathWeaver wants directly from the trajectory columns
+		//
+		template<>
+		inline bool PathWeaverWriter::write<PathTrajectory::const_iterator>(std::ostream& strm, std::vector<std::string>& headers,
+			PathTrajectory::const_iterator first, PathTrajectory::const_iterator last)
+		{
+			(void)headers;
 
-				return true;
+			OutputBuffer& out = OutputBuffer::local();
+
+			out.clear();
+			out << "[\n";
+
+			if (first != last)
+			{
+				const PathTrajectory& traj = *first.trajectory();
+				const std::vector<double>& times = traj.times();
+				const std::vector<double>& velocities = traj.velocities();
+				const std::vector<double>& accelerations = traj.accelerations();
+				const std::vector<double>& curvatures = traj.curvatures();
+				const std::vector<double>& xs = traj.xs();
+				const std::vector<double>& ys = traj.ys();
+				const std::vector<double>& headings = traj.headings();
+
+				for (size_t row = first.index(); row < last.index(); row++)
+				{
+					writePoint(out, row == first.index(), times[row], velocities[row], accelerations[row], curvatures[row],
+						xs[row], ys[row], xero::paths::MathUtils::degreesToRadians(headings[row]));
+				}
+				out << "\n";
 			}
-		};
+
+			out << "]\n";
+			return out.write(strm);
+		}
 	}
 }
-
@@ -0,0 +1,329 @@
+//
+// Copyright 2019 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#include "TrajectoryCache.h"
+#include <BinaryTrajectoryFile.h>
+#include <BinaryTrajectoryReader.h>
+#include <BinaryWriter.h>
+#include <DistanceVelocityConstraint.h>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using namespace xero::paths;
+
+//
+// Change this when a change to the generation code means results in the cache are no
+// longer the results that would be generated
+//
+static constexpr quint32 KeyVersion = 1;
+
+static QDataStream& operator<<(QDataStream& strm, const std::string& str)
+{
+	return strm << QByteArray::fromStdString(str);
+}
+
+TrajectoryCache::TrajectoryCache(const QString& dir, qint64 maxsize)
+{
+	dir_ = dir;
+	maxsize_ = maxsize;
+}
+
+TrajectoryCache::~TrajectoryCache()
+{
+}
+
+QByteArray TrajectoryCache::key(const RobotParams& robot, const RobotPath& path, const Generator& gen,
+	const GeneratorParameterStore& store, const std::string& units, double tolerance)
+{
+	QByteArray data;
+	QDataStream strm(&data, QIODevice::WriteOnly);
+
+	strm.setVersion(QDataStream::Qt_5_12);
+	strm.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+	strm << KeyVersion;
+	strm << units;
+	strm << tolerance;
+
+	//
+	// The path, everything except the name and the flags which are not used to generate it
+	//
+	strm << static_cast<quint64>(path.getPoints().size());
+	for (const Pose2d& pt : path.getPoints())
+	{
+		strm << pt.getTranslation().getX() << pt.getTranslation().getY();
+		strm << pt.getRotation().getCos() << pt.getRotation().getSin();
+	}
+
+	strm << path.getStartVelocity() << path.getEndVelocity();
+	strm << path.getMaxVelocity() << path.getMaxAccel() << path.getMaxJerk() << path.getMaxCentripetal();
+	strm << path.getStartAngle() << path.getStartAngleDelay();
+	strm << path.getEndAngle() << path.getEndAngleDelay();
+
+	strm << static_cast<quint64>(path.getConstraints().size());
+	for (std::shared_ptr<PathConstraint> c : path.getConstraints())
+	{
+		std::shared_ptr<DistanceVelocityConstraint> dv = std::dynamic_pointer_cast<DistanceVelocityConstraint>(c);
+		if (dv == nullptr)
+			return QByteArray();
+
+		strm << std::string(RobotPath::DistanceVelocityTag);
+		strm << dv->getAfter() << dv->getBefore() << dv->getVelocity();
+	}
+
+	//
+	// The robot
+	//
+	strm << static_cast<qint32>(robot.getDriveType());
+	strm << robot.getLengthUnits() << robot.getWeightUnits();
+	strm << robot.getEffectiveWidth() << robot.getEffectiveLength();
+	strm << robot.getRobotWidth() << robot.getRobotLength() << robot.getRobotWeight();
+	strm << robot.getMaxVelocity() << robot.getMaxAccel() << robot.getMaxJerk();
+	strm << robot.getTimestep() << robot.getMaxCentripetalForce();
+
+	//
+	// The generator.  The program and the plugin are built together, so the size and time
+	// of the program stand in for both and catch a rebuilt generator with the same version.
+	//
+	strm << gen.getName() << gen.getVersion().toString();
+	strm << gen.getExec() << gen.getPluginName();
+	strm << gen.getTimestepArg() << gen.getOtherArgs();
+
+	QFileInfo exec(gen.fullPath().c_str());
+	if (exec.exists())
+		strm << exec.size() << exec.lastModified().toMSecsSinceEpoch();
+
+	//
+	// The generator parameters, in name order so the key does not depend on the order
+	// in the generator file
+	//
+	std::vector<const GeneratorParameter*> params;
+	for (const GeneratorParameter& p : gen.getGeneratorParams())
+		params.push_back(&p);
+
+	std::sort(params.begin(), params.end(), [](const GeneratorParameter* a, const GeneratorParameter* b) { return a->getName() < b->getName(); });
+
+	for (const GeneratorParameter* p : params)
+	{
+		QString name = p->getName().c_str();
+
+		strm << p->getName() << p->getType() << p->getArg();
+		strm << store.contains(name);
+		if (store.contains(name))
+			strm << store.value(name);
+	}
+
+	return QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+}
+
+QString TrajectoryCache::entryPath(const QByteArray& key) const
+{
+	return dir_ + "/" + QString::fromLatin1(key) + FileSuffix;
+}
+
+bool TrajectoryCache::makeDirectory()
+{
+	QDir dir(dir_);
+
+	if (dir.exists())
+		return true;
+
+	return QDir().mkpath(dir_);
+}
+
+bool TrajectoryCache::load(const QByteArray& key, RobotPath& path)
+{
+	if (key.isEmpty())
+		return false;
+
+	QFile file(entryPath(key));
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream strm(&file);
+	strm.setVersion(QDataStream::Qt_5_12);
+
+	quint32 magic, version, count;
+	strm >> magic >> version;
+	if (strm.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion)
+		return false;
+
+	PropList props;
+	strm >> count;
+	for (quint32 i = 0; i < count && strm.status() == QDataStream::Ok; i++)
+	{
+		QByteArray name, value;
+		strm >> name >> value;
+		props.push_back(std::make_pair(name.toStdString(), value.toStdString()));
+	}
+
+	std::list<std::shared_ptr<PathTrajectory>> trajs;
+	std::vector<double> aligned;
+	strm >> count;
+	for (quint32 i = 0; i < count && strm.status() == QDataStream::Ok; i++)
+	{
+		QByteArray name, data;
+		strm >> name >> data;
+
+		//
+		// The columns are read in place, so copy them somewhere aligned for doubles
+		//
+		aligned.resize((data.size() + sizeof(double) - 1) / sizeof(double));
+		std::copy(data.constBegin(), data.constEnd(), reinterpret_cast<char*>(aligned.data()));
+
+		BinaryTrajectoryFile bin;
+		auto traj = std::make_shared<PathTrajectory>(name.toStdString());
+		if (!bin.attach(aligned.data(), data.size()) || !BinaryTrajectoryReader::read(bin, *traj))
+		{
+			qDebug() << "trajectory cache entry '" << file.fileName() << "' is not valid - " << bin.error().c_str();
+			return false;
+		}
+
+		trajs.push_back(traj);
+	}
+
+	if (strm.status() != QDataStream::Ok)
+		return false;
+
+	file.close();
+
+	//
+	// Mark the entry as just used
+	//
+	if (file.open(QIODevice::ReadWrite))
+	{
+		file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+		file.close();
+	}
+
+	path.clearTrajectories();
+	for (auto traj : trajs)
+		path.addTrajectory(traj);
+
+	for (const auto& prop : props)
+		path.addProp(prop.first, prop.second);
+
+	return true;
+}
+
+bool TrajectoryCache::save(const QByteArray& key, RobotPath& path, const PropList& props)
+{
+	if (key.isEmpty() || !makeDirectory())
+		return false;
+
+	std::vector<std::string> headers =
+	{
+		RobotPath::TimeTag,
+		RobotPath::XTag,
+		RobotPath::YTag,
+		RobotPath::HeadingTag,
+		RobotPath::PositionTag,
+		RobotPath::VelocityTag,
+		RobotPath::AccelerationTag,
+		RobotPath::JerkTag,
+		RobotPath::CurvatureTag,
+		RobotPath::RotationTag
+	};
+
+	//
+	// Write a new file and move it into place, so another thread or program reading the
+	// entry never sees a partial file
+	//
+	QSaveFile file(entryPath(key));
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+
+	QDataStream strm(&file);
+	strm.setVersion(QDataStream::Qt_5_12);
+
+	strm << FileMagic << FileVersion;
+
+	strm << static_cast<quint32>(props.size());
+	for (const auto& prop : props)
+		strm << prop.first << prop.second;
+
+	std::vector<std::string> names = path.getTrajectoryNames();
+	strm << static_cast<quint32>(names.size());
+	for (const std::string& name : names)
+	{
+		auto traj = path.getTrajectory(name);
+		if (traj == nullptr)
+		{
+			file.cancelWriting();
+			return false;
+		}
+
+		std::ostringstream bin(std::ios::out | std::ios::binary);
+		if (!BinaryWriter::write<PathTrajectory::const_iterator>(bin, headers, traj->begin(), traj->end()))
+		{
+			file.cancelWriting();
+			return false;
+		}
+
+		std::string data = bin.str();
+		strm << name << QByteArray(data.data(), static_cast<int>(data.size()));
+	}
+
+	if (strm.status() != QDataStream::Ok || !file.commit())
+		return false;
+
+	evict();
+	return true;
+}
+
+void TrajectoryCache::evict()
+{
+	std::lock_guard<std::mutex> guard(evict_lock_);
+
+	QDir dir(dir_);
+	QStringList filters;
+	filters << QString("*") + FileSuffix;
+
+	//
+	// Newest first, so the least recently used entries are removed from the back
+	//
+	QFileInfoList files = dir.entryInfoList(filters, QDir::Files, QDir::SortFlag::Time);
+	qint64 total = 0;
+	for (const QFileInfo& info : files)
+		total += info.size();
+
+	while (total > maxsize_ && files.size() > 0)
+	{
+		QFile::remove(files.back().absoluteFilePath());
+		total -= files.back().size();
+		files.pop_back();
+	}
+}
+
+void TrajectoryCache::clear()
+{
+	std::lock_guard<std::mutex> guard(evict_lock_);
+
+	QDir dir(dir_);
+	QStringList filters;
+	filters << QString("*") + FileSuffix;
+
+	for (const QFileInfo& info : dir.entryInfoList(filters, QDir::Files))
+		QFile::remove(info.absoluteFilePath());
+}
@@ -0,0 +1,100 @@
+//
+// Copyright 2019 Jack W. Griffin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+//
+#pragma once
+
+#include "GeneratorParameterStore.h"
+#include "Generator.h"
+#include <RobotParams.h>
+#include <RobotPath.h>
+#include <QByteArray>
+#include <QString>
+#include <list>
+#include <mutex>
+#include <string>
+#include <utility>
+
+//
+// An on disk cache of generated trajectories.  Each entry is named by a hash of everything
+// that goes into generating a path: the waypoints, constraints and limits of the path, the
+// robot, the generator and its parameters.  A path that has not changed since it was last
+// generated, by this program or another one sharing the directory, is read back from the
+// cache instead of being generated again.
+//
+// The cache is kept under a size limit by removing the entries used longest ago.  The
+// modification time of an entry is updated each time it is read so it can serve as the
+// time of last use.
+//
+class TrajectoryCache
+{
+public:
+	typedef std::list<std::pair<std::string, std::string>> PropList;
+
+	static constexpr qint64 DefaultMaxSize = 256 * 1024 * 1024;
+
+public:
+	TrajectoryCache(const QString& dir, qint64 maxsize = DefaultMaxSize);
+	virtual ~TrajectoryCache();
+
+	const QString& directory() const {
+		return dir_;
+	}
+
+	qint64 maxSize() const {
+		return maxsize_;
+	}
+
+	void setMaxSize(qint64 size) {
+		maxsize_ = size;
+	}
+
+	//
+	// The key for a path, or an empty array if the path cannot be cached because it has
+	// something in it the key does not know how to describe
+	//
+	static QByteArray key(const xero::paths::RobotParams& robot, const xero::paths::RobotPath& path, const Generator& gen,
+		const GeneratorParameterStore& store, const std::string& units, double tolerance);
+
+	//
+	// Replace the trajectories of the path with the ones in the cache and add the props that
+	// were stored with them.  Returns false if there is no entry for the key or it cannot be read.
+	//
+	bool load(const QByteArray& key, xero::paths::RobotPath& path);
+
+	//
+	// Store the trajectories of the path, and the props given, under the key
+	//
+	bool save(const QByteArray& key, xero::paths::RobotPath& path, const PropList& props);
+
+	//
+	// Remove every entry in the cache
+	//
+	void clear();
+
+private:
+	static constexpr quint32 FileMagic = 0x58544331;		// XTC1
+	static constexpr quint32 FileVersion = 1;
+	static constexpr const char* FileSuffix = ".xtc";
+
+	QString entryPath(const QByteArray& key) const;
+	bool makeDirectory();
+	void evict();
+
+private:
+	QString dir_;
+	qint64 maxsize_;
+	std::mutex evict_lock_;
+};
+
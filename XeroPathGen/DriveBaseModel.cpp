@@ -36,7 +36,7 @@ double DriveBaseModel::getVelocity(const char* trajname)
 	if (index >= traj->size())
 		index = traj->size() - 1;
 
-	return (*traj)[index].velocity();
+	return traj->velocities()[index];
 }
 
 double DriveBaseModel::getAcceleration(const char* trajname)
@@ -47,7 +47,7 @@ double DriveBaseModel::getAcceleration(const char* trajname)
 	if (index >= traj->size())
 		index = traj->size() - 1;
 
-	return (*traj)[index].acceleration();
+	return traj->accelerations()[index];
 }
 
 Pose2d DriveBaseModel::getPose(const char* trajname)
@@ -58,7 +58,7 @@ Pose2d DriveBaseModel::getPose(const char* trajname)
 	if (index >= traj->size())
 		index = traj->size() - 1;
 
-	return (*traj)[index].pose();
+	return traj->pose(index);
 }
 
 bool DriveBaseModel::isDone()
@@ -71,7 +71,7 @@ double DriveBaseModel::getTime()
 {
 	auto main = getPath()->getTrajectory(TrajectoryName::Main);
 	if (!isDone())
-		return (*main)[index_].time();
+		return main->times()[index_];
 
 	return 0.0;
 }
\ No newline at end of file
@@ -251,7 +251,7 @@ void PathFieldView::drawEquations(QPainter& paint)
 	if (path_ == nullptr)
 		return;
 
-	std::shared_ptr<SplinePair> pair = path_->getSplineAtTime(cursor_time_);
+	const SplinePair* pair = path_->getSplineAtTime(cursor_time_);
 	if (pair != nullptr)
 	{
 		int topgap = 10;
@@ -1146,13 +1146,13 @@ void PathFieldView::drawOnePoint(QPainter& paint, const Pose2d& pt, bool selecte
 
 void PathFieldView::drawSplines(QPainter& paint)
 {
-	auto splines = path_->getSplines();
+	std::vector<SplinePair>& splines = path_->getSplines();
 
 	for (size_t i = 0; i < splines.size(); i++)
 		drawSpline(paint, splines[i]);
 }
 
-void PathFieldView::findSplineStep(std::shared_ptr<xero::paths::SplinePair> pair)
+void PathFieldView::findSplineStep(xero::paths::SplinePair& pair)
 {
 	double step = 0.1;
 	double cx, cy;
@@ -1165,8 +1165,9 @@ void PathFieldView::findSplineStep(std::shared_ptr<xero::paths::SplinePair> pair
 
 		for (double t = 0.0; t < 1.0; t += step) {
 
-			Translation2d loc = pair->evalPosition(t);
-			Rotation2d heading = pair->evalHeading(t);
+			SplineSample s = pair.evalAll(t);
+			Translation2d loc = s.position();
+			Rotation2d heading = s.heading();
 
 			cx = loc.getX() - robot_->getRobotWidth() * heading.getSin() / 2.0;
 			cy = loc.getY() + robot_->getRobotWidth() * heading.getCos() / 2.0;
@@ -1194,10 +1195,10 @@ void PathFieldView::findSplineStep(std::shared_ptr<xero::paths::SplinePair> pair
 		if (maxdist <= 2.0)
 			break;
 	}
-	pair->setStep(step);
+	pair.setStep(step);
 }
 
-void PathFieldView::drawSpline(QPainter& paint, std::shared_ptr<xero::paths::SplinePair> pair)
+void PathFieldView::drawSpline(QPainter& paint, xero::paths::SplinePair& pair)
 {
 	double px, py;
 	QColor c(0xF0, 0x80, 0x80, 0xFF);
@@ -1208,13 +1209,14 @@ void PathFieldView::drawSpline(QPainter& paint, std::shared_ptr<xero::paths::Spl
 	QPen pen(c);
 	paint.setPen(pen);
 
-	if (!pair->hasStep())
+	if (!pair.hasStep())
 		findSplineStep(pair);
 
-	for (float t = 0.0f; t < 1.0f; t += pair->step())
+	for (float t = 0.0f; t < 1.0f; t += pair.step())
 	{
-		Translation2d loc = pair->evalPosition(t);
-		Rotation2d heading = pair->evalHeading(t);
+		SplineSample s = pair.evalAll(t);
+		Translation2d loc = s.position();
+		Rotation2d heading = s.heading();
 
 		px = loc.getX() - robot_->getRobotWidth() * heading.getSin() / 2.0;
 		py = loc.getY() + robot_->getRobotWidth() * heading.getCos() / 2.0;
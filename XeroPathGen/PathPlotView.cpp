@@ -151,10 +151,10 @@ bool PathPlotView::calcMaxVelocity(double &value)
 		if (traj == nullptr)
 			return false;
 
-		for (const auto& pt : *traj)
+		for (double v : traj->velocities())
 		{
-			if (pt.velocity() > value)
-				value = pt.velocity();
+			if (v > value)
+				value = v;
 		}
 	}
 
@@ -328,23 +328,23 @@ double PathPlotView::getValue(std::shared_ptr<PathTrajectory> traj, size_t index
 	switch (t)
 	{
 	case VarType::VTAcceleration:
-		ret = (*traj)[index].acceleration();
+		ret = traj->accelerations()[index];
 		break;
 
 	case VarType::VTVelocity:
-		ret = (*traj)[index].velocity();
+		ret = traj->velocities()[index];
 		break;
 
 	case VarType::VTPosition:
-		ret = (*traj)[index].position();
+		ret = traj->positions()[index];
 		break;
 
 	case VarType::VTJerk:
-		ret = (*traj)[index].jerk();
+		ret = traj->jerks()[index];
 		break;
 
 	case VarType::VTTime:
-	  	ret = (*traj)[index].time() ;
+	  	ret = traj->times()[index] ;
 		break ;
 	}
 
@@ -535,13 +535,14 @@ void PathPlotView::updateWithPath()
 		auto traj = path_->getTrajectory(var.trajectory_);
 		if (traj != nullptr)
 		{
+			const std::vector<double>& times = traj->times();
 			for (size_t i = 0; i < traj->size(); i++) {
-				const Pose2dWithTrajectory& pt = (*traj)[i];
+				double t = times[i];
 
-				if (pt.time() < timemin)
-					timemin = pt.time();
-				if (pt.time() > timemax)
-					timemax = pt.time();
+				if (t < timemin)
+					timemin = t;
+				if (t > timemax)
+					timemax = t;
 
 				double value = getValue(traj, i, var.type_);
 				if (value > maxv)
@@ -550,7 +551,7 @@ void PathPlotView::updateWithPath()
 				if (value < minv)
 					minv = value;
 
-				ser->append(pt.time(), value);
+				ser->append(t, value);
 			}
 
 			setMinMax(VarType::VTTime, timemin, timemax);
@@ -35,7 +35,7 @@ void SwerveDriveBaseModel::reset()
 	auto traj = getPath()->getTrajectory(TrajectoryName::Main);
 	if (traj != nullptr && traj->size() > 0)
 	{
-		location_ = (*traj)[0].pose();
+		location_ = traj->pose(0);
 	}
 
 	//
@@ -63,29 +63,29 @@ void SwerveDriveBaseModel::setDemoStep(size_t t)
 
 	while (getIndex() < t)
 	{
-		double deltafl = (*fltraj)[getIndex()].position() - fllinpos_;
-		const Rotation2d &flhead = (*fltraj)[getIndex()].rotation();
+		double deltafl = fltraj->positions()[getIndex()] - fllinpos_;
+		Rotation2d flhead = fltraj->rotation(getIndex());
 
-		double deltafr = (*frtraj)[getIndex()].position() - frlinpos_;
-		const Rotation2d& frhead = (*frtraj)[getIndex()].rotation();
+		double deltafr = frtraj->positions()[getIndex()] - frlinpos_;
+		Rotation2d frhead = frtraj->rotation(getIndex());
 
-		double deltabl = (*bltraj)[getIndex()].position() - bllinpos_;
-		const Rotation2d& blhead = (*bltraj)[getIndex()].rotation();
+		double deltabl = bltraj->positions()[getIndex()] - bllinpos_;
+		Rotation2d blhead = bltraj->rotation(getIndex());
 
-		double deltabr = (*brtraj)[getIndex()].position() - brlinpos_;
-		const Rotation2d& brhead = (*brtraj)[getIndex()].rotation();
+		double deltabr = brtraj->positions()[getIndex()] - brlinpos_;
+		Rotation2d brhead = brtraj->rotation(getIndex());
 
 		update(deltafl, flhead, deltafr, frhead, deltabl, blhead, deltabr, brhead);
 
-		flpos_ = (*fltraj)[getIndex()].translation();
-		frpos_ = (*frtraj)[getIndex()].translation();
-		blpos_ = (*bltraj)[getIndex()].translation();
-		brpos_ = (*brtraj)[getIndex()].translation();
+		flpos_ = fltraj->translation(getIndex());
+		frpos_ = frtraj->translation(getIndex());
+		blpos_ = bltraj->translation(getIndex());
+		brpos_ = brtraj->translation(getIndex());
 
-		fllinpos_ = (*fltraj)[getIndex()].position();
-		frlinpos_ = (*frtraj)[getIndex()].position();
-		bllinpos_ = (*bltraj)[getIndex()].position();
-		brlinpos_ = (*brtraj)[getIndex()].position();
+		fllinpos_ = fltraj->positions()[getIndex()];
+		frlinpos_ = frtraj->positions()[getIndex()];
+		bllinpos_ = bltraj->positions()[getIndex()];
+		brlinpos_ = brtraj->positions()[getIndex()];
 
 		incrIndex();
 	}
@@ -44,11 +44,11 @@ void TankDriveBaseModel::setDemoStep(size_t t)
 
 	while (getIndex() < t)
 	{
-		double curleft = (*lefttraj)[getIndex()].position();
-		double curright = (*righttraj)[getIndex()].position();
+		double curleft = lefttraj->positions()[getIndex()];
+		double curright = righttraj->positions()[getIndex()];
 		double deltaleft = curleft - leftpos_;
 		double deltaright = curright - rightpos_;
-		update(deltaleft, deltaright, (*lefttraj)[getIndex()].rotation().toDegrees());
+		update(deltaleft, deltaright, lefttraj->headings()[getIndex()]);
 		incrIndex();
 
 		leftpos_ = curleft;
@@ -96,6 +96,6 @@ void TankDriveBaseModel::reset()
 	auto traj = getPath()->getTrajectory(TrajectoryName::Main);
 	if (traj != nullptr && traj->size() > 0)
 	{
-		location_ = (*traj)[0].pose();
+		location_ = traj->pose(0);
 	}
 }
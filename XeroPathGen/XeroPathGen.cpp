@@ -34,6 +34,7 @@
 #include <TrajectoryNames.h>
 #include <JSONWriter.h>
 #include <PathWeaverWriter.h>
+#include <BinaryWriter.h>
 #include <PathGroup.h>
 #include <CSVWriter.h>
 #include <RobotPath.h>
@@ -58,6 +59,7 @@
 #include <QDockWidget>
 #include <QPushButton>
 #include <QActionGroup>
+#include <QStandardPaths>
 
 #include <cstdio>
 #include <iostream>
@@ -218,6 +220,8 @@ XeroPathGen::XeroPathGen(GameFieldManager& fields, GeneratorManager& generators,
 			output_type_ = OutputType::OutputJSON;
 		else if (val == PathWeaverJsonOutputType)
 			output_type_ = OutputType::OutputPathWeaver;
+		else if (val == BinaryOutputType)
+			output_type_ = OutputType::OutputBinary;
 		else
 			output_type_ = OutputType::OutputCSV;
 	}
@@ -302,6 +306,21 @@ XeroPathGen::XeroPathGen(GameFieldManager& fields, GeneratorManager& generators,
 
 	path_timer_->start(timerTickMS);
 
+	//
+	// The engine calls this from its generation threads, so move the work to the GUI thread
+	//
+	path_engine_.setCompleteCallback([this](std::shared_ptr<RobotPath> path) {
+		(void)path;
+		QMetaObject::invokeMethod(this, &XeroPathGen::processCompletePaths, Qt::QueuedConnection);
+	});
+
+	//
+	// Paths that have not changed since they were last generated are read from the cache
+	//
+	QString cachedir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+	if (cachedir.length() > 0)
+		path_engine_.setCache(std::make_shared<TrajectoryCache>(cachedir + "/trajectories"));
+
 	initRecentFiles();
 
 	demo_mode_ = DemoMode::ModeNone;
@@ -960,6 +979,25 @@ void XeroPathGen::setPath(std::shared_ptr<RobotPath> path)
 //
 //////////////////////////////////////////////////////////////////////////////////////////
 
+void XeroPathGen::processCompletePaths()
+{
+	std::shared_ptr<RobotPath> path;
+
+	while ((path = path_engine_.getComplete()) != nullptr)
+	{
+		if (path == current_path_)
+		{
+			plot_main_->update();
+			path_param_model_.reset();
+			if (traj_window_ != nullptr && traj_window_->isShowingPath(path))
+				traj_window_->update();
+
+			if (path_view_->getPath() == path && path->hasFlags())
+				path_view_->update();
+		}
+	}
+}
+
 void XeroPathGen::timerProc()
 {
 	log_messages_lock_.lock();
@@ -974,17 +1012,7 @@ void XeroPathGen::timerProc()
 	}
 	log_messages_lock_.unlock();
 
-	std::shared_ptr<RobotPath> path = path_engine_.getComplete();
-	if (path == current_path_ && path != nullptr)
-	{
-		plot_main_->update();
-		path_param_model_.reset();
-		if (traj_window_ != nullptr && traj_window_->isShowingPath(path))
-			traj_window_->update();
-
-		if (path_view_->getPath() == path && path->hasFlags())
-			path_view_->update();
-	}
+	processCompletePaths();
 
 	if (demo_mode_ != DemoMode::ModeNone)
 	{
@@ -1709,15 +1737,19 @@ void XeroPathGen::generateOnePath(std::shared_ptr<RobotPath> path, const std::st
 	auto t = path->getTrajectory(trajname);
 	if (output_type_ == OutputType::OutputCSV)
 	{
-		CSVWriter::write<std::vector<Pose2dWithTrajectory>::const_iterator>(outfile, headers, t->begin(), t->end());
+		CSVWriter::write<PathTrajectory::const_iterator>(outfile, headers, t->begin(), t->end());
 	}
 	else if (output_type_ == OutputType::OutputPathWeaver)
 	{
-		PathWeaverWriter::write<std::vector<Pose2dWithTrajectory>::const_iterator>(outfile, headers, t->begin(), t->end());
+		PathWeaverWriter::write<PathTrajectory::const_iterator>(outfile, headers, t->begin(), t->end());
+	}
+	else if (output_type_ == OutputType::OutputBinary)
+	{
+		BinaryWriter::write<PathTrajectory::const_iterator>(outfile, headers, t->begin(), t->end());
 	}
 	else
 	{
-		JSONWriter::write<std::vector<Pose2dWithTrajectory>::const_iterator>(outfile, headers, t->begin(), t->end(), path->props());
+		JSONWriter::write<PathTrajectory::const_iterator>(outfile, headers, t->begin(), t->end(), path->props());
 	}
 }
 
@@ -1736,11 +1768,14 @@ void XeroPathGen::generate()
 	setCursor(Qt::WaitCursor);
 	status_text_->setText("Generating Paths");
 
+	//
+	// Wake up as soon as the last path completes, the delay only limits how
+	// often the progress bar is updated
+	//
 	do {
 		pending = static_cast<int>(path_engine_.waitingPaths());
 		prog_bar_->setValue(total - pending);
-		std::this_thread::sleep_for(delay);
-	} while (pending > 0);
+	} while (!path_engine_.waitForComplete(delay));
 
 	status_text_->setText("Writing Paths");
 	count = 0;
@@ -1764,19 +1799,23 @@ void XeroPathGen::generate()
 			{
 				outfile = last_path_dir_ + "/" + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".csv";
 			}
+			else if (output_type_ == OutputType::OutputBinary)
+			{
+				outfile = last_path_dir_ + "/" + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".bin";
+			}
 			else
 			{
 				outfile = last_path_dir_ + "/"  + path->getParent()->getName() + "_" + path->getName() + "_" + trajname + ".json";
 			}
 
 			std::list<std::pair<std::string, std::string>> props;
-			std::ofstream outstrm(outfile);
+			std::ofstream outstrm(outfile, output_type_ == OutputType::OutputBinary ? std::ios::out | std::ios::binary : std::ios::out);
 			generateOnePath(path, trajname, outstrm, props);
 		}
 
 		if (path->getFlags().size() > 0)
 		{
-			if (output_type_ == OutputType::OutputCSV)
+			if (output_type_ == OutputType::OutputCSV || output_type_ == OutputType::OutputBinary)
 			{
 				outfile = last_path_dir_ + "/" + path->getParent()->getName() + "_" + path->getName() + "_flags.csv";
 				CSVFlagsWriter::writeFlags(path, outfile);
@@ -2648,12 +2687,15 @@ void XeroPathGen::editPreferences()
 		value = JsonOutputType;
 	else if (output_type_ == OutputType::OutputPathWeaver)
 		value = PathWeaverJsonOutputType;
+	else if (output_type_ == OutputType::OutputBinary)
+		value = BinaryOutputType;
 
 	prop = std::make_shared<EditableProperty>(PrefDialogOutputFormat, EditableProperty::PropertyType::PTStringList,
 		QVariant(value), "The format for trajectory output");
 	prop->addChoice(JsonOutputType);
 	prop->addChoice(CSVOutputType);
 	prop->addChoice(PathWeaverJsonOutputType);
+	prop->addChoice(BinaryOutputType);
 	dialog.getModel().addProperty(prop);
 
 	prop = std::make_shared<EditableProperty>(PrefDialogOutputFlags, EditableProperty::PropertyType::PTStringList,
@@ -2725,6 +2767,11 @@ void XeroPathGen::editPreferences()
 		output_type_ = OutputType::OutputPathWeaver;
 		settings_.setValue(OutputTypeSetting, value);
 	}
+	else if (value == BinaryOutputType)
+	{
+		output_type_ = OutputType::OutputBinary;
+		settings_.setValue(OutputTypeSetting, value);
+	}
 	else
 	{
 		settings_.remove(OutputTypeSetting);
@@ -221,6 +221,7 @@ private:
 	static constexpr const char* JsonOutputType = "JSON";
 	static constexpr const char* CSVOutputType = "CSV";
 	static constexpr const char* PathWeaverJsonOutputType = "Path Weaver";
+	static constexpr const char* BinaryOutputType = "Binary";
 
 	static const char* RobotDialogName;
 	static const char* RobotDialogEWidth;
@@ -249,6 +250,7 @@ private:
 		OutputCSV,
 		OutputJSON,
 		OutputPathWeaver,
+		OutputBinary,
 	};
 
 	enum class DemoMode
@@ -294,6 +296,7 @@ private:
 	static void messageLogger(QtMsgType type, const QMessageLogContext& context, const QString& msg);
 	void messageLoggerWin(QtMsgType type, const QMessageLogContext& context, const QString& msg);
 	void timerProc();
+	void processCompletePaths();
 
 	void allPathsDirty();
 	void setPathDirty(std::shared_ptr<xero::paths::RobotPath> path);